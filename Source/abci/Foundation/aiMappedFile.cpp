@@ -0,0 +1,145 @@
+#include "pch.h"
+#include "aiMappedFile.h"
+
+#ifndef _WIN32
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+
+MappedFile::MappedFile()
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const char *path)
+{
+    close();
+
+#ifdef _WIN32
+    auto wpath = std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>>().from_bytes(path);
+    HANDLE file = ::CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        ::CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        ::CloseHandle(file);
+        return false;
+    }
+
+    void *data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = (const char*)data;
+    m_size = (size_t)size.QuadPart;
+#else
+    int fd = ::open(path, O_RDONLY);
+    if (fd == -1)
+        return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void *data = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping stays valid after closing the descriptor
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    m_data = (const char*)data;
+    m_size = (size_t)st.st_size;
+#endif
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (!m_data)
+        return;
+
+#ifdef _WIN32
+    ::UnmapViewOfFile(m_data);
+    ::CloseHandle(m_mapping);
+    ::CloseHandle(m_file);
+    m_mapping = m_file = nullptr;
+#else
+    ::munmap((void*)m_data, m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool MappedFile::valid() const { return m_data != nullptr; }
+const char* MappedFile::data() const { return m_data; }
+size_t MappedFile::size() const { return m_size; }
+
+
+MemoryStreamBuf::MemoryStreamBuf(const char *data, size_t size)
+{
+    auto *p = const_cast<char*>(data);
+    setg(p, p, p + size);
+}
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    if ((which & std::ios_base::in) == 0)
+        return pos_type(off_type(-1));
+
+    char *pos = nullptr;
+    switch (dir) {
+    case std::ios_base::beg: pos = eback() + off; break;
+    case std::ios_base::cur: pos = gptr() + off; break;
+    case std::ios_base::end: pos = egptr() + off; break;
+    default: return pos_type(off_type(-1));
+    }
+    if (pos < eback() || pos > egptr())
+        return pos_type(off_type(-1));
+
+    setg(eback(), pos, egptr());
+    return pos_type(off_type(pos - eback()));
+}
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+std::streamsize MemoryStreamBuf::xsgetn(char_type *dst, std::streamsize n)
+{
+    // one memcpy instead of the default per character loop
+    n = std::min<std::streamsize>(n, egptr() - gptr());
+    memcpy(dst, gptr(), (size_t)n);
+    // gbump() takes int. a single read can be 2GB or larger
+    setg(eback(), gptr() + n, egptr());
+    return n;
+}
+
+
+MemoryStream::MemoryStream(const char *data, size_t size)
+    : std::istream(nullptr)
+    , m_buf(data, size)
+{
+    rdbuf(&m_buf);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+// read only memory mapped file
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // path is utf-8
+    bool open(const char *path);
+    void close();
+
+    bool valid() const;
+    const char* data() const;
+    size_t size() const;
+
+private:
+#ifdef _WIN32
+    void *m_file = nullptr;
+    void *m_mapping = nullptr;
+#endif
+    const char *m_data = nullptr;
+    size_t m_size = 0;
+};
+
+
+// std::istream that reads a memory region. each instance has its own position, so many of them can read the
+// same region concurrently.
+class MemoryStreamBuf : public std::streambuf
+{
+public:
+    MemoryStreamBuf(const char *data, size_t size);
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+    std::streamsize xsgetn(char_type *dst, std::streamsize n) override;
+};
+
+class MemoryStream : public std::istream
+{
+public:
+    MemoryStream(const char *data, size_t size);
+
+private:
+    MemoryStreamBuf m_buf;
+};
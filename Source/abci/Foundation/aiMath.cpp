@@ -12,6 +12,27 @@ void ApplyScaleISPC(abcV3 *dst, int num, float scale)
     ispc::Scale((float*)dst, num*3, scale);
 }
 
+void RemapTransformISPC(abcV3 *dst, const abcV3 *src, const int *indices, int num, bool swap_handedness, float scale)
+{
+    float mx = swap_handedness ? -scale : scale;
+    if (indices)
+        ispc::GatherTransform((ispc::float3*)dst, (const ispc::float3*)src, indices, num, mx, scale);
+    else
+        ispc::Transform((ispc::float3*)dst, (const ispc::float3*)src, num, mx, scale);
+}
+
+void RemapTransformLerpISPC(abcV3 *dst1, abcV3 *dst2, abcV3 *dst_int, const abcV3 *src1, const abcV3 *src2, const int *indices,
+    int num, bool swap_handedness, float scale, float w)
+{
+    float mx = swap_handedness ? -scale : scale;
+    if (indices)
+        ispc::GatherTransformLerp((ispc::float3*)dst1, (ispc::float3*)dst2, (ispc::float3*)dst_int,
+            (const ispc::float3*)src1, (const ispc::float3*)src2, indices, num, mx, scale, w);
+    else
+        ispc::TransformLerp((ispc::float3*)dst1, (ispc::float3*)dst2, (ispc::float3*)dst_int,
+            (const ispc::float3*)src1, (const ispc::float3*)src2, num, mx, scale, w);
+}
+
 void NormalizeISPC(abcV3 *dst, int num)
 {
     ispc::Normalize((ispc::float3*)dst, num);
@@ -41,6 +62,11 @@ void MinMaxISPC(abcV3 & min, abcV3 & max, const abcV3 * points, int num)
     ispc::MinMax3((ispc::float3&)min, (ispc::float3&)max, (const ispc::float3*)points, num);
 }
 
+void CopyMinMaxISPC(abcV3 *dst, abcV3 & min, abcV3 & max, const abcV3 * points, int num)
+{
+    ispc::CopyMinMax3((ispc::float3*)dst, (ispc::float3&)min, (ispc::float3&)max, (const ispc::float3*)points, num);
+}
+
 void GenerateNormalsISPC(abcV3 * dst, const abcV3 * points, const int * indices, int num_points, int num_triangles)
 {
     ispc::GenerateNormalsTriangleIndexed((ispc::float3*)dst, (const ispc::float3*)points, indices, num_points, num_triangles);
@@ -54,6 +80,34 @@ void GenerateTangentsISPC(abcV4 *dst,
         (ispc::float4*)dst, (const ispc::float3*)points, (const ispc::float2*)uv, (const ispc::float3*)normals, indices, num_points, num_triangles);
 }
 
+void FloatToHalfISPC(uint16_t *dst, const abcV2 *src, int num)
+{
+    ispc::FloatToHalf((int16_t*)dst, (const float*)src, num * 2);
+}
+void FloatToHalfISPC(uint16_t *dst, const abcV3 *src, int num)
+{
+    ispc::Float3ToHalf4((int16_t*)dst, (const ispc::float3*)src, num);
+}
+void FloatToHalfISPC(uint16_t *dst, const abcC4 *src, int num)
+{
+    ispc::FloatToHalf((int16_t*)dst, (const float*)src, num * 4);
+}
+
+void EncodeNormalsOctahedralISPC(int16_t *dst, const abcV3 *src, int num)
+{
+    ispc::EncodeNormalsOctahedral(dst, (const ispc::float3*)src, num);
+}
+
+void EncodeTangentsOctahedralISPC(int16_t *dst, const abcV4 *src, int num)
+{
+    ispc::EncodeTangentsOctahedral(dst, (const ispc::float4*)src, num);
+}
+
+void FloatToUNorm8ISPC(uint8_t *dst, const abcC4 *src, int num)
+{
+    ispc::FloatToUNorm8(dst, (const float*)src, num * 4);
+}
+
 #endif // aiEnableISPC
 
 
@@ -66,6 +120,36 @@ void ApplyScaleGeneric(abcV3 *dst, int num, float scale)
     }
 }
 
+void RemapTransformGeneric(abcV3 *dst, const abcV3 *src, const int *indices, int num, bool swap_handedness, float scale)
+{
+    abcV3 mul(swap_handedness ? -scale : scale, scale, scale);
+    if (indices) {
+        for (int i = 0; i < num; ++i) {
+            dst[i] = src[indices[i]] * mul;
+        }
+    }
+    else {
+        for (int i = 0; i < num; ++i) {
+            dst[i] = src[i] * mul;
+        }
+    }
+}
+
+void RemapTransformLerpGeneric(abcV3 *dst1, abcV3 *dst2, abcV3 *dst_int, const abcV3 *src1, const abcV3 *src2, const int *indices,
+    int num, bool swap_handedness, float scale, float w)
+{
+    abcV3 mul(swap_handedness ? -scale : scale, scale, scale);
+    float iw = 1.0f - w;
+    for (int i = 0; i < num; ++i) {
+        int si = indices ? indices[i] : i;
+        abcV3 v1 = src1[si] * mul;
+        abcV3 v2 = src2[si] * mul;
+        dst1[i] = v1;
+        dst2[i] = v2;
+        dst_int[i] = (v1 * iw) + (v2 * w);
+    }
+}
+
 void LerpGeneric(abcV2 *dst, const abcV2 *v1, const abcV2 *v2, int num, float w)
 {
     float iw = 1.0f - w;
@@ -119,6 +203,24 @@ void MinMaxGeneric(abcV3 &dst_min, abcV3 &dst_max, const abcV3 *src_, int num)
     dst_max = (abcV3&)rmax;
 }
 
+void CopyMinMaxGeneric(abcV3 *dst_, abcV3 &dst_min, abcV3 &dst_max, const abcV3 *src_, int num)
+{
+    if (num == 0) { return; }
+
+    auto *dst = (float3*)dst_;
+    auto *src = (const float3*)src_;
+    auto rmin = src[0];
+    auto rmax = src[0];
+    for (int i = 0; i < num; ++i) {
+        auto t = src[i];
+        dst[i] = t;
+        rmin = min(rmin, t);
+        rmax = max(rmax, t);
+    }
+    dst_min = (abcV3&)rmin;
+    dst_max = (abcV3&)rmax;
+}
+
 void GenerateNormalsGeneric(abcV3 *dst, const abcV3 *points, const int *indices, int num_points, int num_triangles)
 {
     memset(dst, 0, sizeof(abcV3)*num_points);
@@ -173,6 +275,100 @@ void GenerateTangentsGeneric(abcV4 *dst_,
 }
 
 
+// round to nearest even. overflows become inf. to_half() in aiSIMD.ispc must give the same bits
+static inline uint16_t ToHalf(float f)
+{
+    uint32_t x;
+    memcpy(&x, &f, sizeof(x));
+    uint32_t sign = (x >> 16) & 0x8000;
+    uint32_t a = x & 0x7fffffff;
+    if (a >= 0x47800000) // inf, nan or too large
+        return uint16_t(sign | (a > 0x7f800000 ? 0x7e00 : 0x7c00));
+    if (a < 0x38800000) { // subnormal or zero
+        float af;
+        memcpy(&af, &a, sizeof(af));
+        return uint16_t(sign | (uint32_t)std::nearbyint(af * 16777216.0f));
+    }
+    // rebias the exponent and round the dropped 13 bits
+    a += 0xc8000fff + ((a >> 13) & 1);
+    return uint16_t(sign | (a >> 13));
+}
+
+// round to nearest even, same as round() of ISPC
+static inline int16_t ToSNorm16(float v)
+{
+    return (int16_t)std::nearbyint(clamp(v, -1.0f, 1.0f) * 32767.0f);
+}
+
+static inline uint8_t ToUNorm8(float v)
+{
+    return (uint8_t)std::nearbyint(clamp(v, 0.0f, 1.0f) * 255.0f);
+}
+
+static inline void EncodeOctahedral(int16_t *dst, float x, float y, float z)
+{
+    float d = std::abs(x) + std::abs(y) + std::abs(z);
+    if (d > 0.0f) {
+        float rd = 1.0f / d;
+        x *= rd; y *= rd; z *= rd;
+    }
+    if (z < 0.0f) {
+        float ox = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float oy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = ox; y = oy;
+    }
+    dst[0] = ToSNorm16(x);
+    dst[1] = ToSNorm16(y);
+}
+
+void FloatToHalfGeneric(uint16_t *dst, const abcV2 *src, int num)
+{
+    auto *s = (const float*)src;
+    for (int i = 0; i < num * 2; ++i) {
+        dst[i] = ToHalf(s[i]);
+    }
+}
+void FloatToHalfGeneric(uint16_t *dst, const abcV3 *src, int num)
+{
+    for (int i = 0; i < num; ++i) {
+        dst[i * 4 + 0] = ToHalf(src[i].x);
+        dst[i * 4 + 1] = ToHalf(src[i].y);
+        dst[i * 4 + 2] = ToHalf(src[i].z);
+        dst[i * 4 + 3] = 0;
+    }
+}
+void FloatToHalfGeneric(uint16_t *dst, const abcC4 *src, int num)
+{
+    auto *s = (const float*)src;
+    for (int i = 0; i < num * 4; ++i) {
+        dst[i] = ToHalf(s[i]);
+    }
+}
+
+void EncodeNormalsOctahedralGeneric(int16_t *dst, const abcV3 *src, int num)
+{
+    for (int i = 0; i < num; ++i) {
+        EncodeOctahedral(dst + i * 2, src[i].x, src[i].y, src[i].z);
+    }
+}
+
+void EncodeTangentsOctahedralGeneric(int16_t *dst, const abcV4 *src, int num)
+{
+    for (int i = 0; i < num; ++i) {
+        EncodeOctahedral(dst + i * 4, src[i].x, src[i].y, src[i].z);
+        dst[i * 4 + 2] = ToSNorm16(src[i].w);
+        dst[i * 4 + 3] = 0;
+    }
+}
+
+void FloatToUNorm8Generic(uint8_t *dst, const abcC4 *src, int num)
+{
+    auto *s = (const float*)src;
+    for (int i = 0; i < num * 4; ++i) {
+        dst[i] = ToUNorm8(s[i]);
+    }
+}
+
 // > generic implementation
 
 
@@ -201,6 +397,17 @@ void ApplyScale(abcV3 *dst, int num, float scale)
     Impl(ApplyScale, dst, num, scale);
 }
 
+void RemapTransform(abcV3 *dst, const abcV3 *src, const int *indices, int num, bool swap_handedness, float scale)
+{
+    Impl(RemapTransform, dst, src, indices, num, swap_handedness, scale);
+}
+
+void RemapTransformLerp(abcV3 *dst1, abcV3 *dst2, abcV3 *dst_int, const abcV3 *src1, const abcV3 *src2, const int *indices,
+    int num, bool swap_handedness, float scale, float w)
+{
+    Impl(RemapTransformLerp, dst1, dst2, dst_int, src1, src2, indices, num, swap_handedness, scale, w);
+}
+
 void Normalize(abcV3 *dst, int num)
 {
     Impl(Normalize, dst, num);
@@ -231,6 +438,11 @@ void MinMax(abcV3 &min, abcV3 &max, const abcV3 *points, int num)
     Impl(MinMax, min, max, points, num);
 }
 
+void CopyMinMax(abcV3 *dst, abcV3 &min, abcV3 &max, const abcV3 *points, int num)
+{
+    Impl(CopyMinMax, dst, min, max, points, num);
+}
+
 void GenerateNormals(abcV3 *dst, const abcV3 *points, const int *indices, int num_points, int num_triangles)
 {
     Impl(GenerateNormals, dst, points, indices, num_points, num_triangles);
@@ -243,6 +455,34 @@ void GenerateTangents(abcV4 *dst,
     Impl(GenerateTangents, dst, points, uv, normals, indices, num_points, num_triangles);
 }
 
+void FloatToHalf(uint16_t *dst, const abcV2 *src, int num)
+{
+    Impl(FloatToHalf, dst, src, num);
+}
+void FloatToHalf(uint16_t *dst, const abcV3 *src, int num)
+{
+    Impl(FloatToHalf, dst, src, num);
+}
+void FloatToHalf(uint16_t *dst, const abcC4 *src, int num)
+{
+    Impl(FloatToHalf, dst, src, num);
+}
+
+void EncodeNormalsOctahedral(int16_t *dst, const abcV3 *src, int num)
+{
+    Impl(EncodeNormalsOctahedral, dst, src, num);
+}
+
+void EncodeTangentsOctahedral(int16_t *dst, const abcV4 *src, int num)
+{
+    Impl(EncodeTangentsOctahedral, dst, src, num);
+}
+
+void FloatToUNorm8(uint8_t *dst, const abcC4 *src, int num)
+{
+    Impl(FloatToUNorm8, dst, src, num);
+}
+
 #undef Impl
 
 
@@ -1340,20 +1340,42 @@ template<class T> inline tvec4<T> orthogonalize_tangent(
 void SwapHandedness(abcV3 *dst, int num);
 void SwapHandedness(abcV4 *dst, int num);
 void ApplyScale(abcV3 *dst, int num, float scale);
+// dst[i] = src[indices[i]] (src[i] if indices is null), with handedness swapped and scaled. one pass instead of
+// a gather + SwapHandedness() + ApplyScale(). dst can be src if indices is null.
+void RemapTransform(abcV3 *dst, const abcV3 *src, const int *indices, int num, bool swap_handedness, float scale);
+// RemapTransform() both ends of an interpolated frame into dst1 and dst2, and write their interpolation at w to dst_int
+void RemapTransformLerp(abcV3 *dst1, abcV3 *dst2, abcV3 *dst_int, const abcV3 *src1, const abcV3 *src2, const int *indices,
+    int num, bool swap_handedness, float scale, float w);
 void Normalize(abcV3 *dst, int num);
 void Lerp(abcV2 *dst, const abcV2 *v1, const abcV2 *v2, int num, float w);
 void Lerp(abcV3 *dst, const abcV3 *v1, const abcV3 *v2, int num, float w);
 void Lerp(abcC4 *dst, const abcC4 *v1, const abcC4 *v2, int num, float w);
 void GenerateVelocities(abcV3 *dst, const abcV3 *p1, const abcV3 *p2, int num, float motion_scale);
 void MinMax(abcV3& min, abcV3& max, const abcV3 *points, int num);
+// memcpy() + MinMax() in one pass
+void CopyMinMax(abcV3 *dst, abcV3& min, abcV3& max, const abcV3 *points, int num);
 void GenerateNormals(abcV3 *dst, const abcV3 *points, const int *indices, int num_points, int num_triangles);
 void GenerateTangents(abcV4 *dst,
     const abcV3 *points, const abcV2 *uv, const abcV3 *normals, const int *indices,
     int num_points, int num_triangles);
+// vertex format conversions. half values are raw bits. abcV3 becomes half4 with w = 0
+void FloatToHalf(uint16_t *dst, const abcV2 *src, int num);
+void FloatToHalf(uint16_t *dst, const abcV3 *src, int num);
+void FloatToHalf(uint16_t *dst, const abcC4 *src, int num);
+// octahedral encoded unit vectors in snorm16x2. tangents are followed by (w, 0) in snorm16x2
+void EncodeNormalsOctahedral(int16_t *dst, const abcV3 *src, int num);
+void EncodeTangentsOctahedral(int16_t *dst, const abcV4 *src, int num);
+void FloatToUNorm8(uint8_t *dst, const abcC4 *src, int num);
 
 // for test and debug
 void ApplyScaleGeneric(abcV3 *dst, int num, float scale);
 void ApplyScaleISPC(abcV3 *dst, int num, float scale);
+void RemapTransformGeneric(abcV3 *dst, const abcV3 *src, const int *indices, int num, bool swap_handedness, float scale);
+void RemapTransformISPC(abcV3 *dst, const abcV3 *src, const int *indices, int num, bool swap_handedness, float scale);
+void RemapTransformLerpGeneric(abcV3 *dst1, abcV3 *dst2, abcV3 *dst_int, const abcV3 *src1, const abcV3 *src2, const int *indices,
+    int num, bool swap_handedness, float scale, float w);
+void RemapTransformLerpISPC(abcV3 *dst1, abcV3 *dst2, abcV3 *dst_int, const abcV3 *src1, const abcV3 *src2, const int *indices,
+    int num, bool swap_handedness, float scale, float w);
 void NormalizeGeneric(abcV3 *dst, int num);
 void NormalizeISPC(abcV3 *dst, int num);
 void LerpGeneric(abcV2 *dst, const abcV2 *v1, const abcV2 *v2, int num, float w);
@@ -1366,6 +1388,8 @@ void GenerateVelocitiesGeneric(abcV3 *dst, const abcV3 *p1, const abcV3 *p2, int
 void GenerateVelocitiesISPC(abcV3 *dst, const abcV3 *p1, const abcV3 *p2, int num, float motion_scale);
 void MinMaxGeneric(abcV3& min, abcV3& max, const abcV3 *points, int num);
 void MinMaxISPC(abcV3& min, abcV3& max, const abcV3 *points, int num);
+void CopyMinMaxGeneric(abcV3 *dst, abcV3& min, abcV3& max, const abcV3 *points, int num);
+void CopyMinMaxISPC(abcV3 *dst, abcV3& min, abcV3& max, const abcV3 *points, int num);
 void GenerateNormalsGeneric(abcV3 *dst, const abcV3 *points, const int *indices, int num_points, int num_triangles);
 void GenerateNormalsISPC(abcV3 *dst, const abcV3 *points, const int *indices, int num_points, int num_triangles);
 void GenerateTangentsGeneric(abcV4 *dst,
@@ -1374,3 +1398,15 @@ void GenerateTangentsGeneric(abcV4 *dst,
 void GenerateTangentsISPC(abcV4 *dst,
     const abcV3 *points, const abcV2 *uv, const abcV3 *normals, const int *indices,
     int num_points, int num_triangles);
+void FloatToHalfGeneric(uint16_t *dst, const abcV2 *src, int num);
+void FloatToHalfGeneric(uint16_t *dst, const abcV3 *src, int num);
+void FloatToHalfGeneric(uint16_t *dst, const abcC4 *src, int num);
+void FloatToHalfISPC(uint16_t *dst, const abcV2 *src, int num);
+void FloatToHalfISPC(uint16_t *dst, const abcV3 *src, int num);
+void FloatToHalfISPC(uint16_t *dst, const abcC4 *src, int num);
+void EncodeNormalsOctahedralGeneric(int16_t *dst, const abcV3 *src, int num);
+void EncodeNormalsOctahedralISPC(int16_t *dst, const abcV3 *src, int num);
+void EncodeTangentsOctahedralGeneric(int16_t *dst, const abcV4 *src, int num);
+void EncodeTangentsOctahedralISPC(int16_t *dst, const abcV4 *src, int num);
+void FloatToUNorm8Generic(uint8_t *dst, const abcC4 *src, int num);
+void FloatToUNorm8ISPC(uint8_t *dst, const abcC4 *src, int num);
@@ -1,112 +1,27 @@
 #include "pch.h"
 #include "aiMeshOps.h"
+#include "Importer/aiAsync.h"
 
+// faces per task in retopology() and indices per task in genSubmeshes()
+static const int parallel_grain = 0x4000;
 
-namespace impl
+// splits [0, n) into blocks of grain and runs body(begin, end) for each block on aiThreadPool.
+// a single block runs on the calling thread.
+template<class Body>
+static inline void ParallelFor(int n, int grain, const Body& body)
 {
-    template<class Indices, class Counts>
-    inline void BuildConnection(
-        MeshConnectionInfo& connection, const Indices& indices, const Counts& counts, const IArray<float3>& vertices)
-    {
-        size_t num_points = vertices.size();
-        size_t num_faces = counts.size();
-        size_t num_indices = indices.size();
-
-        connection.v2f_offsets.resize_discard(num_points);
-        connection.v2f_faces.resize_discard(num_indices);
-        connection.v2f_indices.resize_discard(num_indices);
-
-        connection.v2f_counts.resize_zeroclear(num_points);
-        {
-            int ii = 0;
-            for (size_t fi = 0; fi < num_faces; ++fi) {
-                int c = counts[fi];
-                for (int ci = 0; ci < c; ++ci) {
-                    connection.v2f_counts[indices[ii + ci]]++;
-                }
-                ii += c;
-            }
-
-            int offset = 0;
-            for (size_t i = 0; i < num_points; ++i) {
-                connection.v2f_offsets[i] = offset;
-                offset += connection.v2f_counts[i];
-            }
-        }
-
-        connection.v2f_counts.zeroclear();
-        {
-            int i = 0;
-            for (int fi = 0; fi < (int)num_faces; ++fi) {
-                int c = counts[fi];
-                for (int ci = 0; ci < c; ++ci) {
-                    int vi = indices[i + ci];
-                    int ti = connection.v2f_offsets[vi] + connection.v2f_counts[vi]++;
-                    connection.v2f_faces[ti] = fi;
-                    connection.v2f_indices[ti] = i + ci;
-                }
-                i += c;
-            }
-        }
+    if (n <= grain) {
+        if (n > 0)
+            body(0, n);
+        return;
     }
-}
 
-void MeshConnectionInfo::clear()
-{
-    v2f_counts.clear();
-    v2f_offsets.clear();
-    v2f_faces.clear();
-    v2f_indices.clear();
-
-    weld_map.clear();
-    weld_counts.clear();
-    weld_offsets.clear();
-    weld_indices.clear();
-}
-
-void MeshConnectionInfo::buildConnection(
-    const IArray<int>& indices, const IArray<int>& counts, const IArray<float3>& vertices)
-{
-    size_t num_points = vertices.size();
-    size_t num_faces = counts.size();
-    size_t num_indices = indices.size();
-
-    v2f_offsets.resize_discard(num_points);
-    v2f_faces.resize_discard(num_indices);
-    v2f_indices.resize_discard(num_indices);
-
-    v2f_counts.resize_zeroclear(num_points);
-    {
-        int ii = 0;
-        for (size_t fi = 0; fi < num_faces; ++fi) {
-            int c = counts[fi];
-            for (int ci = 0; ci < c; ++ci) {
-                v2f_counts[indices[ii + ci]]++;
-            }
-            ii += c;
-        }
-
-        int offset = 0;
-        for (size_t i = 0; i < num_points; ++i) {
-            v2f_offsets[i] = offset;
-            offset += v2f_counts[i];
-        }
-    }
-
-    v2f_counts.zeroclear();
-    {
-        int i = 0;
-        for (int fi = 0; fi < (int)num_faces; ++fi) {
-            int c = counts[fi];
-            for (int ci = 0; ci < c; ++ci) {
-                int vi = indices[i + ci];
-                int ti = v2f_offsets[vi] + v2f_counts[vi]++;
-                v2f_faces[ti] = fi;
-                v2f_indices[ti] = i + ci;
-            }
-            i += c;
-        }
+    aiTaskGroup group;
+    for (int begin = 0; begin < n; begin += grain) {
+        int end = std::min(begin + grain, n);
+        group.run([&body, begin, end]() { body(begin, end); });
     }
+    group.wait();
 }
 
 
@@ -171,37 +86,86 @@ void MeshRefiner::retopology(bool swap_faces)
     new_indices_lines.resize_discard(getLinesIndexCountTotal());
     new_indices_points.resize_discard(getPointsIndexCountTotal());
 
-    auto& src = new_indices;
-    auto dst_tri = new_indices_tri.data();
-    auto dst_lines = new_indices_lines.data();
-    auto dst_points = new_indices_points.data();
-
     const int i1 = swap_faces ? 2 : 1;
     const int i2 = swap_faces ? 1 : 2;
-    size_t num_faces = counts.size();
+    int num_faces = (int)counts.size();
 
-    int n = 0;
-    for (size_t fi = 0; fi < num_faces; ++fi) {
-        int count = counts[fi];
-        if (count >= 3) {
-            if (!gen_triangles)continue;
-            for (int ni = 0; ni < count - 2; ++ni) {
-                *(dst_tri++) = src[n + 0];
-                *(dst_tri++) = src[n + ni + i1];
-                *(dst_tri++) = src[n + ni + i2];
+    // count source and destination indices of each block of faces, then emit all blocks in parallel from
+    // their prefix sums
+    struct Block
+    {
+        int src, tri, lines, points;
+    };
+    int num_blocks = (num_faces + parallel_grain - 1) / parallel_grain;
+    RawVector<Block> blocks;
+    blocks.resize_zeroclear(num_blocks);
+
+    ParallelFor(num_blocks, 1, [&](int bb, int be) {
+        for (int bi = bb; bi < be; ++bi) {
+            auto& b = blocks[bi];
+            int fe = std::min((bi + 1) * parallel_grain, num_faces);
+            for (int fi = bi * parallel_grain; fi < fe; ++fi) {
+                int count = counts[fi];
+                if (count >= 3) {
+                    if (!gen_triangles)continue;
+                    b.tri += (count - 2) * 3;
+                }
+                else if (count == 2) {
+                    if (!gen_lines)continue;
+                    b.lines += 2;
+                }
+                else if (count == 1) {
+                    if (!gen_points)continue;
+                    b.points += 1;
+                }
+                b.src += count;
             }
         }
-        else if (count == 2) {
-            if (!gen_lines)continue;
-            for (int ni = 0; ni < 2; ++ni)
-                *(dst_lines++) = src[n + ni];
-        }
-        else if (count == 1) {
-            if (!gen_points)continue;
-            *(dst_points++) = src[n];
-        }
-        n += count;
+    });
+
+    Block total{};
+    for (auto& b : blocks) {
+        Block t = b;
+        b = total;
+        total.src += t.src;
+        total.tri += t.tri;
+        total.lines += t.lines;
+        total.points += t.points;
     }
+
+    ParallelFor(num_blocks, 1, [&](int bb, int be) {
+        for (int bi = bb; bi < be; ++bi) {
+            auto& b = blocks[bi];
+            const int *src = new_indices.data();
+            auto dst_tri = new_indices_tri.data() + b.tri;
+            auto dst_lines = new_indices_lines.data() + b.lines;
+            auto dst_points = new_indices_points.data() + b.points;
+
+            int n = b.src;
+            int fe = std::min((bi + 1) * parallel_grain, num_faces);
+            for (int fi = bi * parallel_grain; fi < fe; ++fi) {
+                int count = counts[fi];
+                if (count >= 3) {
+                    if (!gen_triangles)continue;
+                    for (int ni = 0; ni < count - 2; ++ni) {
+                        *(dst_tri++) = src[n + 0];
+                        *(dst_tri++) = src[n + ni + i1];
+                        *(dst_tri++) = src[n + ni + i2];
+                    }
+                }
+                else if (count == 2) {
+                    if (!gen_lines)continue;
+                    for (int ni = 0; ni < 2; ++ni)
+                        *(dst_lines++) = src[n + ni];
+                }
+                else if (count == 1) {
+                    if (!gen_points)continue;
+                    *(dst_points++) = src[n];
+                }
+                n += count;
+            }
+        }
+    });
 }
 
 void MeshRefiner::genSubmeshes(IArray<int> material_ids)
@@ -309,6 +273,29 @@ void MeshRefiner::genSubmeshes()
     const int *src_points = new_indices_points.data();
     int *dst_indices = new_indices_submeshes.data();
 
+    // offsets of all submeshes are known up front. only the copies are done in parallel.
+    // large submeshes are divided so that a mesh with a single split still spreads across workers.
+    struct CopyJob
+    {
+        const int *src;
+        int *dst;
+        int count;
+        int offset_vertices;
+    };
+    RawVector<CopyJob> jobs;
+
+    auto add_submesh = [&](Topology topology, const int *&src, int index_count, int offset_vertices) {
+        Submesh sm;
+        sm.topology = topology;
+        sm.index_count = index_count;
+        sm.index_offset = (int)std::distance(new_indices_submeshes.data(), dst_indices);
+        for (int i = 0; i < index_count; i += parallel_grain)
+            jobs.push_back({ src + i, dst_indices + i, std::min(parallel_grain, index_count - i), offset_vertices });
+        src += index_count;
+        dst_indices += index_count;
+        submeshes.push_back(sm);
+    };
+
     int num_splits = (int)splits.size();
     for (int spi = 0; spi < num_splits; ++spi) {
         auto& split = splits[spi];
@@ -316,39 +303,30 @@ void MeshRefiner::genSubmeshes()
 
         // triangles
         if (split.index_count_tri > 0) {
-            Submesh sm;
-            sm.index_count = split.index_count_tri;
-            sm.index_offset = (int)std::distance(new_indices_submeshes.data(), dst_indices);
-            for (int ii = 0; ii < sm.index_count; ++ii)
-                *(dst_indices++) = *(src_tri++) - offset_vertices;
-            submeshes.push_back(sm);
+            add_submesh(Topology::Triangles, src_tri, split.index_count_tri, offset_vertices);
             ++split.submesh_count;
         }
 
         // lines
         if (split.index_count_lines > 0) {
-            Submesh sm;
-            sm.topology = Topology::Lines;
-            sm.index_count = split.index_count_lines;
-            sm.index_offset = (int)std::distance(new_indices_submeshes.data(), dst_indices);
-            for (int ii = 0; ii < sm.index_count; ++ii)
-                *(dst_indices++) = *(src_lines++) - offset_vertices;
-            submeshes.push_back(sm);
+            add_submesh(Topology::Lines, src_lines, split.index_count_lines, offset_vertices);
             ++split.submesh_count;
         }
 
         // points
         if (split.index_count_points > 0) {
-            Submesh sm;
-            sm.topology = Topology::Points;
-            sm.index_count = split.index_count_points;
-            sm.index_offset = (int)std::distance(new_indices_submeshes.data(), dst_indices);
-            for (int ii = 0; ii < sm.index_count; ++ii)
-                *(dst_indices++) = *(src_points++) - offset_vertices;
-            submeshes.push_back(sm);
+            add_submesh(Topology::Points, src_points, split.index_count_points, offset_vertices);
             ++split.submesh_count;
         }
     }
+
+    ParallelFor((int)jobs.size(), 1, [&](int jb, int je) {
+        for (int ji = jb; ji < je; ++ji) {
+            auto& job = jobs[ji];
+            for (int ii = 0; ii < job.count; ++ii)
+                job.dst[ii] = job.src[ii] - job.offset_vertices;
+        }
+    });
     setupSubmeshes();
 }
 
@@ -375,14 +353,7 @@ void MeshRefiner::clear()
     counts.reset();
     indices.reset();
     points.reset();
-    for (auto& attr : attributes) {
-        attr->clear();
-        // attributes are placement new-ed, so need to call destructor manually
-        attr->~IAttribute();
-    }
-    attributes.clear();
 
-    old2new_indices.clear();
     new2old_points.clear();
 
     new_indices.clear();
@@ -394,107 +365,136 @@ void MeshRefiner::clear()
     new_points.clear();
     splits.clear();
     submeshes.clear();
-    connection.clear();
 }
 
-void MeshRefiner::refine()
+void MeshRefiner::parallelFor(int n, int grain, const std::function<void(int begin, int end)>& body)
 {
-    if (connection.v2f_counts.size() != points.size()) {
-        connection.buildConnection(indices, counts, points);
+    ParallelFor(n, grain, body);
+}
+
+int MeshRefiner::partitionCorners(WeldContext& wc) const
+{
+    int num_indices = (int)indices.size();
+    int num_threads = aiThreadPool::instance().getThreadCount();
+    int num_partitions = num_threads > 1 && num_indices > weld_grain ? num_threads * 4 : 1;
+
+    wc.partition_offsets.resize_discard(num_partitions + 1);
+    wc.partition_corners.resize_discard(num_indices);
+    if (num_partitions == 1) {
+        wc.partition_offsets[0] = 0;
+        wc.partition_offsets[1] = num_indices;
+        std::iota(wc.partition_corners.begin(), wc.partition_corners.end(), 0);
+        return 1;
+    }
+
+    // high bits of the hash. low bits are used by the tables of the partitions
+    auto partition_of = [&](int ii) {
+        return (int)(((uint64_t)wc.hashes[ii] * (uint32_t)num_partitions) >> 32);
+    };
+
+    // counting sort. each block counts its corners per partition, then scatters them from the prefix sums
+    int num_blocks = (num_indices + weld_grain - 1) / weld_grain;
+    RawVector<int> block_offsets;
+    block_offsets.resize_zeroclear(num_blocks * num_partitions);
+
+    ParallelFor(num_blocks, 1, [&](int bb, int be) {
+        for (int bi = bb; bi < be; ++bi) {
+            int *dst = &block_offsets[bi * num_partitions];
+            int ie = std::min((bi + 1) * weld_grain, num_indices);
+            for (int ii = bi * weld_grain; ii < ie; ++ii)
+                dst[partition_of(ii)]++;
+        }
+    });
+
+    int offset = 0;
+    for (int pi = 0; pi < num_partitions; ++pi) {
+        wc.partition_offsets[pi] = offset;
+        for (int bi = 0; bi < num_blocks; ++bi) {
+            int& o = block_offsets[bi * num_partitions + pi];
+            int count = o;
+            o = offset;
+            offset += count;
+        }
     }
+    wc.partition_offsets[num_partitions] = offset;
+
+    ParallelFor(num_blocks, 1, [&](int bb, int be) {
+        for (int bi = bb; bi < be; ++bi) {
+            int *dst = &block_offsets[bi * num_partitions];
+            int ie = std::min((bi + 1) * weld_grain, num_indices);
+            for (int ii = bi * weld_grain; ii < ie; ++ii)
+                wc.partition_corners[dst[partition_of(ii)]++] = ii;
+        }
+    });
+    return num_partitions;
+}
 
+int MeshRefiner::emitWelded(WeldContext& wc)
+{
+    int num_faces = (int)counts.size();
     int num_indices = (int)indices.size();
-    new_points.reserve(num_indices);
-    new_indices.reserve(num_indices);
-    for (auto& attr : attributes) { attr->prepare((int)points.size(), (int)indices.size()); }
 
-    old2new_indices.resize(num_indices, -1);
+    // vertices are not shared across splits. a representative whose vertex is in an earlier split emits again.
+    wc.vertices.resize_discard(num_indices);
+    memset(wc.vertices.data(), -1, num_indices * sizeof(int));
+    wc.new2ii.clear();
+    wc.new2ii.reserve(num_indices);
+    new_indices.resize_discard(num_indices);
 
-    int num_faces_total = (int)counts.size();
     int offset_faces = 0;
     int offset_indices = 0;
-    int offset_vertices = 0;
-    int num_faces = 0;
-    int num_indices_tri = 0;
-    int num_indices_lines = 0;
-    int num_indices_points = 0;
+    Split split{};
 
     auto add_new_split = [&]() {
-        auto split = Split{};
-        split.face_offset = offset_faces;
-        split.index_offset = offset_indices;
-        split.vertex_offset = offset_vertices;
-        split.face_count = num_faces;
-        split.index_count_tri = num_indices_tri;
-        split.index_count_lines = num_indices_lines;
-        split.index_count_points = num_indices_points;
-        split.vertex_count = (int)new_points.size() - offset_vertices;
-        split.index_count = (int)new_indices.size() - offset_indices;
+        split.vertex_count = (int)wc.new2ii.size() - split.vertex_offset;
+        split.index_count = offset_indices - split.index_offset;
         splits.push_back(split);
 
-        offset_faces += split.face_count;
-        offset_indices += split.index_count;
-        offset_vertices += split.vertex_count;
-
-        num_faces = 0;
-        num_indices_tri = 0;
-        num_indices_lines = 0;
-        num_indices_points = 0;
-    };
-
-    auto compare_all_attributes = [&](int ni, int ii) -> bool {
-        for (auto& attr : attributes)
-            if (!attr->compare(ni, ii)) { return false; }
-        return true;
-    };
-
-    auto find_or_emit_vertex = [&](int vi, int ii) -> int {
-        int offset = connection.v2f_offsets[vi];
-        int connection_count = connection.v2f_counts[vi];
-        for (int ci = 0; ci < connection_count; ++ci) {
-            int& ni = old2new_indices[connection.v2f_indices[offset + ci]];
-            if (ni != -1 && compare_all_attributes(ni, ii)) {
-                return ni;
-            }
-            else {
-                ni = (int)new_points.size();
-                new_points.push_back(points[vi]);
-                new2old_points.push_back(vi);
-                for (auto& attr : attributes) { attr->emit(ii); }
-                return ni;
-            }
-        }
-        return 0;
+        split = Split{};
+        split.face_offset = offset_faces;
+        split.index_offset = offset_indices;
+        split.vertex_offset = (int)wc.new2ii.size();
     };
 
     int offset = 0;
-    for (int fi = 0; fi < num_faces_total; ++fi) {
+    for (int fi = 0; fi < num_faces; ++fi) {
         int count = counts[fi];
-        if ((count >= 3 && gen_triangles) || (count == 2 && gen_lines) || (count == 1 && gen_points))
-        {
-            if (split_unit > 0 && (int)new_points.size() - offset_vertices + count > split_unit) {
+        if ((count >= 3 && gen_triangles) || (count == 2 && gen_lines) || (count == 1 && gen_points)) {
+            if (split_unit > 0 && split.face_count > 0 && (int)wc.new2ii.size() - split.vertex_offset + count > split_unit)
                 add_new_split();
 
-                // clear vertex cache
-                memset(old2new_indices.data(), -1, old2new_indices.size() * sizeof(int));
-            }
-
             for (int ci = 0; ci < count; ++ci) {
                 int ii = offset + ci;
-                int vi = indices[ii];
-                new_indices.push_back(find_or_emit_vertex(vi, ii));
+                int& ni = wc.vertices[wc.reps[ii]];
+                if (ni < split.vertex_offset) {
+                    ni = (int)wc.new2ii.size();
+                    wc.new2ii.push_back(ii);
+                }
+                new_indices[offset_indices++] = ni;
             }
-            ++num_faces;
+            ++split.face_count;
+            ++offset_faces;
             if (count >= 3)
-                num_indices_tri += (count - 2) * 3;
+                split.index_count_tri += (count - 2) * 3;
             else if (count == 2)
-                num_indices_lines += 2;
+                split.index_count_lines += 2;
             else if (count == 1)
-                num_indices_points += 1;
-
+                split.index_count_points += 1;
         }
         offset += count;
     }
     add_new_split();
+    new_indices.resize(offset_indices);
+
+    int vertex_count = (int)wc.new2ii.size();
+    new_points.resize_discard(vertex_count);
+    new2old_points.resize_discard(vertex_count);
+    ParallelFor(vertex_count, weld_grain, [&](int begin, int end) {
+        for (int ni = begin; ni < end; ++ni) {
+            int vi = indices[wc.new2ii[ni]];
+            new_points[ni] = points[vi];
+            new2old_points[ni] = vi;
+        }
+    });
+    return vertex_count;
 }
-
@@ -4,46 +4,6 @@
 #include "aiMath.h"
 
 
-struct MeshConnectionInfo
-{
-    RawVector<int> v2f_counts;
-    RawVector<int> v2f_offsets;
-    RawVector<int> v2f_faces;
-    RawVector<int> v2f_indices;
-
-    RawVector<int> weld_map;
-    RawVector<int> weld_counts;
-    RawVector<int> weld_offsets;
-    RawVector<int> weld_indices;
-
-    void clear();
-    void buildConnection(
-        const IArray<int>& indices, const IArray<int>& counts, const IArray<float3>& vertices);
-
-    // Body: [](int face_index, int index_index) -> void
-    template<class Body>
-    void eachConnectedFaces(int vi, const Body& body) const
-    {
-        int count = v2f_counts[vi];
-        int offset = v2f_offsets[vi];
-        for (int i = 0; i < count; ++i) {
-            body(v2f_faces[offset + i], v2f_indices[offset + i]);
-        }
-    }
-
-    // Body: [](int vertex_index) -> void
-    template<class Body>
-    void eachWeldedVertices(int vi, const Body& body) const
-    {
-        int count = weld_counts[vi];
-        int offset = weld_offsets[vi];
-        for (int i = 0; i < count; ++i) {
-            body(weld_indices[offset + i]);
-        }
-    }
-};
-
-
 class MeshWelder
 {
 public:
@@ -116,7 +76,6 @@ struct MeshRefiner
     IArray<float3> points;
 
     // outputs
-    RawVector<int> old2new_indices; // old index to new index
     RawVector<int> new2old_points;  // new index to old vertex
     RawVector<int> new_indices;     // non-triangulated new indices
     RawVector<int> new_indices_tri;
@@ -126,136 +85,195 @@ struct MeshRefiner
     RawVector<float3> new_points;
     RawVector<Split> splits;
     RawVector<Submesh> submeshes;
-    MeshConnectionInfo connection;
-
-    // attributes
-    template<class T>
-    void addIndexedAttribute(const IArray<T>& values, const IArray<int>& indices, RawVector<T>& new_values, RawVector<int>& new2old)
-    {
-        auto attr = newAttribute<IndexedAttribute<T>>();
-        attr->values = values;
-        attr->indices = indices;
-        attr->new_values = &new_values;
-        attr->new2old = &new2old;
-    }
 
+    // attribute of refineHashed(). values are indexed by indices, or directly by index index if indices is empty.
+    // an attribute that is not assigned is ignored.
     template<class T>
-    void addExpandedAttribute(const IArray<T>& values, RawVector<T>& new_values, RawVector<int>& new2old)
+    struct Attribute
     {
-        auto attr = newAttribute<ExpandedAttribute<T>>();
-        attr->values = values;
-        attr->new_values = &new_values;
-        attr->new2old = &new2old;
-    }
-
-    void refine();
-    void retopology(bool swap_faces);
-    void genSubmeshes(IArray<int> material_ids);
-    void genSubmeshes();
-    void clear();
-
-    int getTrianglesIndexCountTotal() const;
-    int getLinesIndexCountTotal() const;
-    int getPointsIndexCountTotal() const;
+        IArray<T> values;
+        IArray<int> indices;
+        RawVector<T> *new_values = nullptr;
+        RawVector<int> *new2old = nullptr;
 
-private:
-    void setupSubmeshes();
+        void assign(const IArray<T>& v, const IArray<int>& i, RawVector<T>& nv, RawVector<int>& n2o)
+        {
+            values = v;
+            indices = i;
+            new_values = &nv;
+            new2old = &n2o;
+        }
 
-    class IAttribute
-    {
-    public:
-        virtual ~IAttribute() {}
-        virtual void prepare(int vertex_count, int index_count) = 0;
-        virtual bool compare(int vertex_index, int index_index) = 0;
-        virtual void emit(int index_index) = 0;
-        virtual void clear() = 0;
-    };
+        bool valid() const { return new_values != nullptr; }
+        int source(int ii) const { return indices.empty() ? ii : indices[ii]; }
 
-    template<class T>
-    class IndexedAttribute : public IAttribute
-    {
-    public:
-        void prepare(int vertex_count, int index_count) override
+        uint32_t hash(int ii) const
         {
-            clear();
+            static_assert(sizeof(T) % sizeof(uint32_t) == 0, "");
+            if (!valid())
+                return 0;
+            auto *words = (const uint32_t*)&values[source(ii)];
+            uint32_t h = 2166136261u;
+            for (size_t i = 0; i < sizeof(T) / sizeof(uint32_t); ++i)
+                h = (h ^ words[i]) * 16777619u;
+            return h;
         }
 
-        bool compare(int ni, int ii) override
+        bool equals(int ii1, int ii2) const
         {
-            return (*new_values)[ni] == values[indices[ii]];
+            return !valid() || values[source(ii1)] == values[source(ii2)];
         }
 
-        void emit(int ii) override
+        void resize(int vertex_count)
         {
-            int i = indices[ii];
-            new_values->push_back(values[i]);
-            new2old->push_back(i);
+            if (!valid())
+                return;
+            new_values->resize_discard(vertex_count);
+            new2old->resize_discard(vertex_count);
         }
 
-        void clear() override
+        void set(int ni, int ii)
         {
-            new_values->clear();
-            new2old->clear();
+            if (!valid())
+                return;
+            int i = source(ii);
+            (*new_values)[ni] = values[i];
+            (*new2old)[ni] = i;
         }
-
-        IArray<T> values;
-        IArray<int> indices;
-        RawVector<T> *new_values = nullptr;
-        RawVector<int> *new2old = nullptr;
     };
 
-    template<class T>
-    class ExpandedAttribute : public IAttribute
-    {
-    public:
-        void prepare(int vertex_count, int index_count) override
-        {
-            clear();
-        }
+    // corners are deduplicated through open addressing tables keyed by a hash of the point index and all attribute
+    // values. every identical corner in a split is welded, and the result doesn't depend on the number of worker
+    // threads. the attribute set is fixed at compile time, so there are no virtual calls in the inner loop.
+    template<class... Attributes>
+    void refineHashed(Attributes&... attrs);
+    void retopology(bool swap_faces);
+    void genSubmeshes(IArray<int> material_ids);
+    void genSubmeshes();
+    void clear();
 
-        bool compare(int ni, int ii) override
-        {
-            return (*new_values)[ni] == values[ii];
-        }
+    int getTrianglesIndexCountTotal() const;
+    int getLinesIndexCountTotal() const;
+    int getPointsIndexCountTotal() const;
 
-        void emit(int ii) override
-        {
-            new_values->push_back(values[ii]);
-            new2old->push_back(ii);
-        }
+private:
+    void setupSubmeshes();
 
-        void clear() override
-        {
-            new_values->clear();
-        }
+    // corners per task in refineHashed()
+    static const int weld_grain = 0x4000;
 
-        IArray<T> values;
-        RawVector<T> *new_values = nullptr;
-        RawVector<int> *new2old = nullptr;
+    // intermediates of refineHashed(). per index index unless noted
+    struct WeldContext
+    {
+        RawVector<uint32_t> hashes;
+        RawVector<int> reps;                // first index index with the same point and attributes
+        RawVector<int> partition_offsets;   // per partition + 1
+        RawVector<int> partition_corners;   // index indices sorted by partition, in index order within a partition
+        RawVector<int> vertices;            // new vertex of each representative corner in the current split
+        RawVector<int> new2ii;              // per new vertex. index index that emitted it
     };
 
-    template<class AttrType>
-    AttrType* newAttribute()
+    static void parallelFor(int n, int grain, const std::function<void(int begin, int end)>& body);
+    // sorts corners into partitions by their hashes. returns the number of partitions
+    int partitionCorners(WeldContext& wc) const;
+    // emits a vertex for each representative corner per split, and writes splits, new_indices, new_points and
+    // new2old_points. returns the vertex count
+    int emitWelded(WeldContext& wc);
+
+    static uint32_t hashAttributes(int) { return 0; }
+    template<class A, class... Rest>
+    static uint32_t hashAttributes(int ii, const A& a, const Rest&... rest)
+    {
+        return (a.hash(ii) * 31) ^ hashAttributes(ii, rest...);
+    }
+
+    static bool equalAttributes(int, int) { return true; }
+    template<class A, class... Rest>
+    static bool equalAttributes(int ii1, int ii2, const A& a, const Rest&... rest)
     {
-        const int size_attr = sizeof(IndexedAttribute<char>);
-        if (buf_attributes.empty())
-            buf_attributes.resize(size_attr * max_attributes);
-
-        size_t i = attributes.size();
-        if (i >= max_attributes)
-            return nullptr;
-        auto *ret = new (&buf_attributes[size_attr * i]) AttrType();
-        attributes.push_back(ret);
-        return ret;
+        return a.equals(ii1, ii2) && equalAttributes(ii1, ii2, rest...);
     }
 
-    RawVector<IAttribute*> attributes;
-    RawVector<char> buf_attributes;
-    static const int max_attributes = 8; // you can increase this if needed
+    static void resizeAttributes(int) {}
+    template<class A, class... Rest>
+    static void resizeAttributes(int vertex_count, A& a, Rest&... rest)
+    {
+        a.resize(vertex_count);
+        resizeAttributes(vertex_count, rest...);
+    }
+
+    static void setAttributes(int, int) {}
+    template<class A, class... Rest>
+    static void setAttributes(int ni, int ii, A& a, Rest&... rest)
+    {
+        a.set(ni, ii);
+        setAttributes(ni, ii, rest...);
+    }
 };
 
 
 
+template<class... Attributes>
+inline void MeshRefiner::refineHashed(Attributes&... attrs)
+{
+    WeldContext wc;
+    int num_indices = (int)indices.size();
+
+    wc.hashes.resize_discard(num_indices);
+    parallelFor(num_indices, weld_grain, [&](int begin, int end) {
+        for (int ii = begin; ii < end; ++ii) {
+            uint32_t h = ((uint32_t)indices[ii] * 2654435761u) ^ hashAttributes(ii, attrs...);
+            h ^= h >> 16;
+            h *= 0x85ebca6bu;
+            h ^= h >> 13;
+            wc.hashes[ii] = h;
+        }
+    });
+
+    // identical corners have the same hash, so they always land in the same partition. each partition picks the
+    // first corner of every distinct key in index order, which makes the representatives independent of the
+    // partitioning.
+    int num_partitions = partitionCorners(wc);
+    wc.reps.resize_discard(num_indices);
+    parallelFor(num_partitions, 1, [&](int pb, int pe) {
+        RawVector<int> table;
+        for (int pi = pb; pi < pe; ++pi) {
+            const int *corners = wc.partition_corners.data() + wc.partition_offsets[pi];
+            int n = wc.partition_offsets[pi + 1] - wc.partition_offsets[pi];
+
+            uint32_t table_size = 1;
+            while (table_size < (uint32_t)n * 2)
+                table_size <<= 1;
+            uint32_t hash_mask = table_size - 1;
+            table.resize_discard(table_size);
+            memset(table.data(), -1, table_size * sizeof(int));
+
+            for (int i = 0; i < n; ++i) {
+                int ii = corners[i];
+                uint32_t h = wc.hashes[ii];
+                for (uint32_t slot = h & hash_mask; ; slot = (slot + 1) & hash_mask) {
+                    int rep = table[slot];
+                    if (rep == -1) {
+                        table[slot] = ii;
+                        wc.reps[ii] = ii;
+                        break;
+                    }
+                    if (wc.hashes[rep] == h && indices[rep] == indices[ii] && equalAttributes(rep, ii, attrs...)) {
+                        wc.reps[ii] = rep;
+                        break;
+                    }
+                }
+            }
+        }
+    });
+
+    int vertex_count = emitWelded(wc);
+    resizeAttributes(vertex_count, attrs...);
+    parallelFor(vertex_count, weld_grain, [&](int begin, int end) {
+        for (int ni = begin; ni < end; ++ni)
+            setAttributes(ni, wc.new2ii[ni], attrs...);
+    });
+}
 
 
 inline uint32_t MeshWelder::hash(const abcV3& value)
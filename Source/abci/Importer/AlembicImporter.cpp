@@ -21,6 +21,7 @@ abciAPI abcSampleSelector aiIndexToSampleSelector(int64_t index)
 
 abciAPI void aiCleanup()
 {
+    aiThreadPool::shutdown();
 }
 
 abciAPI void aiClearContextsWithPath(const char *path)
@@ -28,6 +29,11 @@ abciAPI void aiClearContextsWithPath(const char *path)
     aiContextManager::destroyContextsWithPath(path);
 }
 
+abciAPI bool aiSetThreadCount(int n)
+{
+    return aiThreadPool::setThreadCount(n);
+}
+
 abciAPI aiContext* aiContextCreate(int uid)
 {
     return aiContextManager::getContext(uid);
@@ -45,6 +51,31 @@ abciAPI bool aiContextLoad(aiContext* ctx, const char *path)
     return ctx ? ctx->load(path) : false;
 }
 
+abciAPI bool aiContextLoadFiltered(aiContext* ctx, const char *path, const char *filter)
+{
+    return ctx ? ctx->load(path, filter) : false;
+}
+
+abciAPI bool aiContextLoadAsync(aiContext* ctx, const char *path, const char *filter)
+{
+    return ctx ? ctx->loadAsync(path, filter) : false;
+}
+
+abciAPI aiLoadState aiContextGetLoadState(aiContext* ctx)
+{
+    return ctx ? ctx->getLoadState() : aiLoadState::None;
+}
+
+abciAPI float aiContextGetLoadProgress(aiContext* ctx)
+{
+    return ctx ? ctx->getLoadProgress() : 0.0f;
+}
+
+abciAPI bool aiContextWaitLoad(aiContext* ctx)
+{
+    return ctx ? ctx->waitLoad() : false;
+}
+
 abciAPI void aiContextSetConfig(aiContext* ctx, const aiConfig* conf)
 {
     if (ctx)
@@ -78,6 +109,42 @@ abciAPI void aiContextUpdateSamples(aiContext* ctx, double time)
         ctx->updateSamples(time);
 }
 
+abciAPI void aiContextSetViewFrustums(aiContext* ctx, const aiFrustum *frustums, int count)
+{
+    if (ctx)
+        ctx->setViewFrustums(frustums, count);
+}
+
+abciAPI void aiContextBakeRange(aiContext* ctx, double begin, double end)
+{
+    if (ctx)
+        ctx->bakeRange(begin, end);
+}
+
+abciAPI void aiContextGetSampleCacheStats(aiContext* ctx, aiSampleCacheStats *dst)
+{
+    if (ctx && dst)
+        ctx->getSampleCache().getStats(*dst);
+}
+
+abciAPI void aiContextGetHierarchySummary(aiContext* ctx, aiHierarchySummary *dst)
+{
+    if (ctx && dst)
+        ctx->getHierarchySummary(*dst);
+}
+
+abciAPI void aiContextGetHierarchy(aiContext* ctx, aiHierarchyData *dst)
+{
+    if (ctx && dst)
+        ctx->getHierarchy(*dst);
+}
+
+abciAPI void aiContextUpdateAndFillPolyMeshes(aiContext* ctx, double time, const aiPolyMeshBatchRecord *records, int count, aiPolyMeshBatchResult *dst)
+{
+    if (ctx && records && dst)
+        ctx->updateAndFillPolyMeshes(time, records, count, dst);
+}
+
 
 abciAPI int aiTimeSamplingGetSampleCount(aiTimeSampling *self)
 {
@@ -181,6 +248,11 @@ abciAPI bool aiSchemaIsDataUpdated(aiSchema* schema)
     return schema ? schema->isDataUpdated() : false;
 }
 
+abciAPI bool aiSchemaIsCulled(aiSchema* schema)
+{
+    return schema ? schema->isCulled() : false;
+}
+
 abciAPI int aiSchemaGetNumProperties(aiSchema* schema)
 {
     return schema->getNumProperties();
@@ -242,6 +314,30 @@ abciAPI void aiPolyMeshFillVertexBuffer(aiPolyMeshSample* sample, aiPolyMeshData
         sample->fillVertexBuffer(vbs, ibs);
 }
 
+abciAPI void aiPolyMeshSetVertexBuffers(aiPolyMesh* schema, const aiPolyMeshData* vbs, int split_count)
+{
+    if (schema)
+        schema->setVertexBuffers(vbs, split_count);
+}
+
+abciAPI void aiPolyMeshSetVertexFormats(aiPolyMesh* schema, const aiPolyMeshVertexFormats* formats)
+{
+    if (schema && formats)
+        schema->setVertexFormats(*formats);
+}
+
+abciAPI void aiPolyMeshSetIndexFormat(aiPolyMesh* schema, aiIndexFormat format)
+{
+    if (schema)
+        schema->setIndexFormat(format);
+}
+
+abciAPI void aiPolyMeshSetSkipUnchanged(aiPolyMesh* schema, bool v)
+{
+    if (schema)
+        schema->setSkipUnchanged(v);
+}
+
 abciAPI void aiCameraGetData(aiCameraSample* sample, aiCameraData *dst)
 {
     if (sample)
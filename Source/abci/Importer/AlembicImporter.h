@@ -95,6 +95,61 @@ enum class aiPropertyType
     ArrayTypeEnd     = Float4x4Array,
 };
 
+enum class aiSchemaType
+{
+    None, // plain object
+    Xform,
+    Camera,
+    PolyMesh,
+    Points,
+};
+
+enum class aiLoadState
+{
+    None,
+    Loading,
+    Succeeded,
+    Failed,
+};
+
+enum class aiBatchStatus
+{
+    Filled,
+    NotUpdated,  // data is not changed since the last update. buffers are untouched
+    NeedsResize, // topology changed or buffers are too small. sample is updated; set up buffers from its summaries and fill it
+    Invalid,
+};
+
+// output format of a vertex attribute in aiPolyMeshFillVertexBuffer(). unsupported combinations are treated as Float
+enum class aiVertexFormat
+{
+    Float,          // float3 points / velocities / normals, float4 tangents / colors, float2 uvs
+    Half,           // half4 (w = 0) points / velocities, half4 colors, half2 uvs
+    SNorm16Oct,     // octahedral encoded normals in snorm16x2. tangents add (w, 0) in snorm16x2
+    UNorm8,         // unorm8x4 colors
+};
+
+// width of the indices in aiPolyMeshFillVertexBuffer()
+enum class aiIndexFormat
+{
+    UInt32,
+    UInt16IfPossible, // uint16_t for splits with up to 65536 vertices. see aiMeshSplitSummary::index_size
+};
+
+// bits of aiMeshSampleSummary::changed and aiPolyMeshBatchResult::changed
+enum aiPolyMeshAttributeBits : uint32_t
+{
+    aiPolyMeshAttr_Points       = 1 << 0,
+    aiPolyMeshAttr_Velocities   = 1 << 1,
+    aiPolyMeshAttr_Normals      = 1 << 2,
+    aiPolyMeshAttr_Tangents     = 1 << 3,
+    aiPolyMeshAttr_UV0          = 1 << 4,
+    aiPolyMeshAttr_UV1          = 1 << 5,
+    aiPolyMeshAttr_Colors       = 1 << 6,
+    aiPolyMeshAttr_Indices      = 1 << 7,
+    aiPolyMeshAttr_All          = 0xff,
+};
+
 struct aiConfig
 {
     aiNormalsMode normals_mode = aiNormalsMode::ComputeIfMissing;
@@ -111,6 +166,51 @@ struct aiConfig
     bool import_point_polygon = true;
     bool import_line_polygon = true;
     bool import_triangle_polygon = true;
+
+    bool parallel_update = false; // update schemas in parallel in aiContextUpdateSamples(). async_load is ignored if enabled
+    int read_ahead_samples = 0; // number of samples read ahead in playback direction. 0: disabled
+    int64_t sample_cache_budget = 0; // bytes of cooked samples kept for revisiting. 0: disabled
+    bool eager_load = false; // build the whole object tree in aiContextLoad(). otherwise children are built on first access
+    // use the archive's self bounds of meshes as the bounds of every split. otherwise they are used only for single
+    // split meshes, and the bounds of each split are computed while its points are copied
+    bool trust_file_bounds = false;
+    // read only the visibility of hidden mesh and points samples. the last visible data is kept as it is.
+    // enable only if the host hides objects by visibility.
+    bool skip_hidden_samples = false;
+};
+
+struct aiSampleCacheStats
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t used_bytes = 0;
+    uint64_t budget_bytes = 0;
+    int entry_count = 0;
+};
+
+// view frustum in the space of the top object, after scale_factor and swap_handedness are applied.
+// a point p is inside if dot(planes[i].xyz, p) + planes[i].w >= 0 for all planes.
+struct aiFrustum
+{
+    abcV4 planes[6];
+};
+
+struct aiHierarchySummary
+{
+    int node_count = 0;
+    int name_buffer_size = 0; // in bytes, including null terminators
+};
+
+// each array has node_count elements in depth first order. index 0 is the top object. any of them can be null.
+struct aiHierarchyData
+{
+    aiObject **objects = nullptr;
+    int *parent_indices = nullptr; // -1 for the top object
+    aiSchemaType *schema_types = nullptr;
+    int *name_offsets = nullptr;   // offsets in names
+    char *names = nullptr;         // null terminated names packed into name_buffer_size bytes
+    int *time_sampling_indices = nullptr; // 0 for non-schema objects
+    bool *constant_flags = nullptr; // true for non-schema objects
 };
 
 struct aiXformData
@@ -137,6 +237,18 @@ struct aiCameraData
     float aperture = 2.4f;          // in cm. vertical one
 };
 
+// the pointers in aiPolyMeshData are reinterpreted to these formats
+struct aiPolyMeshVertexFormats
+{
+    aiVertexFormat points = aiVertexFormat::Float;
+    aiVertexFormat velocities = aiVertexFormat::Float;
+    aiVertexFormat normals = aiVertexFormat::Float;
+    aiVertexFormat tangents = aiVertexFormat::Float;
+    aiVertexFormat uv0 = aiVertexFormat::Float;
+    aiVertexFormat uv1 = aiVertexFormat::Float;
+    aiVertexFormat colors = aiVertexFormat::Float;
+};
+
 struct aiMeshSummary
 {
     aiTopologyVariance topology_variance = aiTopologyVariance::Constant;
@@ -167,6 +279,7 @@ struct aiMeshSampleSummary
     int vertex_count = 0;
     int index_count = 0;
     bool topology_changed = false;
+    uint32_t changed = aiPolyMeshAttr_All; // aiPolyMeshAttributeBits. attributes changed since the last fill
 };
 
 struct aiMeshSplitSummary
@@ -177,6 +290,7 @@ struct aiMeshSplitSummary
     int vertex_offset = 0;
     int index_count = 0;
     int index_offset = 0;
+    int index_size = 4; // bytes per index written to aiSubmeshData::indices of the submeshes of this split
 };
 
 struct aiSubmeshSummary
@@ -207,8 +321,25 @@ struct aiPolyMeshData
 
 struct aiSubmeshData
 {
-    int *indices = nullptr;
+    int *indices = nullptr; // uint16_t* if index_size of the split is 2
+    int index_count = 0; // capacity of indices. checked only by aiContextUpdateAndFillPolyMeshes()
+};
 
+// vertex_count of each vbs is the capacity of its buffers. checked only by aiContextUpdateAndFillPolyMeshes()
+struct aiPolyMeshBatchRecord
+{
+    aiPolyMesh *schema = nullptr;
+    aiPolyMeshData *vbs = nullptr;  // split_count elements
+    aiSubmeshData *ibs = nullptr;   // submesh_count elements
+    int split_count = 0;
+    int submesh_count = 0;
+};
+
+struct aiPolyMeshBatchResult
+{
+    aiBatchStatus status = aiBatchStatus::Invalid;
+    bool visibility = true;
+    uint32_t changed = 0; // aiPolyMeshAttributeBits. attributes written by this fill
 };
 
 struct aiPointsSummary
@@ -252,18 +383,45 @@ struct aiPropertyData
 
 abciAPI abcSampleSelector aiTimeToSampleSelector(double time);
 abciAPI abcSampleSelector aiIndexToSampleSelector(int64_t index);
+// stops the worker threads. call this before the module is unloaded. async work runs on the calling thread after this.
 abciAPI void            aiCleanup();
 abciAPI void            aiClearContextsWithPath(const char *path);
+// worker threads for async load, shared by all contexts. 0: one per hardware thread.
+// must be called before the first context is used. returns false if the pool is already running.
+abciAPI bool            aiSetThreadCount(int n);
 
 abciAPI aiContext*      aiContextCreate(int uid);
 abciAPI void            aiContextDestroy(aiContext* ctx);
 abciAPI bool            aiContextLoad(aiContext* ctx, const char *path);
+// filter: ';' separated list of node paths. '*' and '?' can be used in each path element (e.g. "/root/char_A/*").
+// only matched nodes, their descendants and ancestors are built.
+abciAPI bool            aiContextLoadFiltered(aiContext* ctx, const char *path, const char *filter);
+// open on a background thread. filter can be null. poll with aiContextGetLoadState() / aiContextGetLoadProgress().
+// other aiContext* functions wait for the load to complete.
+abciAPI bool            aiContextLoadAsync(aiContext* ctx, const char *path, const char *filter);
+abciAPI aiLoadState     aiContextGetLoadState(aiContext* ctx);
+abciAPI float           aiContextGetLoadProgress(aiContext* ctx); // 0.0 - 1.0
+abciAPI bool            aiContextWaitLoad(aiContext* ctx);
 abciAPI void            aiContextSetConfig(aiContext* ctx, const aiConfig* conf);
 abciAPI int             aiContextGetTimeSamplingCount(aiContext* ctx);
 abciAPI aiTimeSampling* aiContextGetTimeSampling(aiContext* ctx, int i);
 abciAPI void            aiContextGetTimeRange(aiContext* ctx, double *begin, double *end);
 abciAPI aiObject*       aiContextGetTopObject(aiContext* ctx);
 abciAPI void            aiContextUpdateSamples(aiContext* ctx, double time);
+// meshes and points whose self bounds are outside of all frustums skip reading and cooking in updates until they
+// are inside again. their last samples stay as they are. the bounds are placed with the xforms in the archive.
+// count = 0 disables culling. forced updates by aiSchemaUpdateSample() are never culled.
+abciAPI void            aiContextSetViewFrustums(aiContext* ctx, const aiFrustum *frustums, int count);
+// cook all samples in [begin, end] into memory. end < begin releases baked data.
+abciAPI void            aiContextBakeRange(aiContext* ctx, double begin, double end);
+abciAPI void            aiContextGetSampleCacheStats(aiContext* ctx, aiSampleCacheStats *dst);
+// snapshot of the whole object tree. builds all children that are not created yet.
+// allocate buffers with the sizes in aiHierarchySummary and pass them to aiContextGetHierarchy().
+abciAPI void            aiContextGetHierarchySummary(aiContext* ctx, aiHierarchySummary *dst);
+abciAPI void            aiContextGetHierarchy(aiContext* ctx, aiHierarchyData *dst);
+// update, cook and fill all records in parallel. equivalent to aiSchemaUpdateSample() + aiSchemaSync() +
+// aiPolyMeshFillVertexBuffer() for each, except that unchanged samples are not re-cooked or filled.
+abciAPI void            aiContextUpdateAndFillPolyMeshes(aiContext* ctx, double time, const aiPolyMeshBatchRecord *records, int count, aiPolyMeshBatchResult *dst);
 
 abciAPI int             aiTimeSamplingGetSampleCount(aiTimeSampling *self);
 abciAPI double          aiTimeSamplingGetTime(aiTimeSampling *self, int index);
@@ -286,6 +444,8 @@ abciAPI void            aiSchemaUpdateSample(aiSchema* schema, const abcSampleSe
 abciAPI void            aiSchemaSync(aiSchema* schema);
 abciAPI bool            aiSchemaIsConstant(aiSchema* schema);
 abciAPI bool            aiSchemaIsDataUpdated(aiSchema* schema);
+// true if the last update was skipped by aiContextSetViewFrustums()
+abciAPI bool            aiSchemaIsCulled(aiSchema* schema);
 abciAPI int             aiSchemaGetNumProperties(aiSchema* schema);
 abciAPI aiProperty*     aiSchemaGetPropertyByIndex(aiSchema* schema, int i);
 abciAPI aiProperty*     aiSchemaGetPropertyByName(aiSchema* schema, const char *name);
@@ -299,6 +459,20 @@ abciAPI void            aiPolyMeshGetSampleSummary(aiPolyMeshSample* sample, aiM
 abciAPI void            aiPolyMeshGetSplitSummaries(aiPolyMeshSample* sample, aiMeshSplitSummary *dst);
 abciAPI void            aiPolyMeshGetSubmeshSummaries(aiPolyMeshSample* sample, aiSubmeshSummary* dst);
 abciAPI void            aiPolyMeshFillVertexBuffer(aiPolyMeshSample* sample, aiPolyMeshData* vbs, aiSubmeshData* ibs);
+// register persistent per split vertex buffers. outputs that are recomputed every frame (interpolation, generated
+// normals / tangents / velocities) are written straight into them while they match the topology, and
+// aiPolyMeshFillVertexBuffer() skips an attribute if its destination is the buffer it was written into.
+// registering another set before each update gives double buffering. replacing or unregistering (vbs = nullptr)
+// waits for the pending cook and fill and copies the current sample's outputs out of the old buffers, so they can be
+// released after the call.
+abciAPI void            aiPolyMeshSetVertexBuffers(aiPolyMesh* schema, const aiPolyMeshData* vbs, int split_count);
+// attributes in other formats than Float are converted during aiPolyMeshFillVertexBuffer() and are never written
+// straight into registered vertex buffers
+abciAPI void            aiPolyMeshSetVertexFormats(aiPolyMesh* schema, const aiPolyMeshVertexFormats* formats);
+abciAPI void            aiPolyMeshSetIndexFormat(aiPolyMesh* schema, aiIndexFormat format);
+// if true, aiPolyMeshFillVertexBuffer() writes only attributes changed since the last fill. this assumes the same
+// buffers are filled every time. bounds are written with points.
+abciAPI void            aiPolyMeshSetSkipUnchanged(aiPolyMesh* schema, bool v);
 
 abciAPI void            aiCameraGetData(aiCameraSample* sample, aiCameraData *dst);
 
@@ -2,67 +2,228 @@
 #include "aiAsync.h"
 
 
-aiAsyncManager::~aiAsyncManager()
+static thread_local int t_worker_index = -1;
+
+static std::mutex s_pool_config_mutex;
+static int s_pool_thread_count = 0;
+static bool s_pool_started = false;
+
+aiThreadPool& aiThreadPool::instance()
 {
-    if (m_future.valid())
-        m_future.wait();
+    // intentionally leaked. joining workers in a static destructor deadlocks under the loader lock on DLL unload
+    static aiThreadPool *s_instance = new aiThreadPool();
+    return *s_instance;
 }
 
-aiAsyncManager& aiAsyncManager::instance()
+aiThreadPool::aiThreadPool()
 {
-    static aiAsyncManager s_instance;
-    return s_instance;
+    std::lock_guard<std::mutex> lock(s_pool_config_mutex);
+    s_pool_started = true;
+    start(s_pool_thread_count);
 }
 
-void aiAsyncManager::queue(aiAsync *task)
+bool aiThreadPool::setThreadCount(int n)
 {
-    queue(&task, 1);
+    // resizing a running pool would race with enqueue() from other contexts
+    std::lock_guard<std::mutex> lock(s_pool_config_mutex);
+    if (s_pool_started)
+        return false;
+    s_pool_thread_count = n;
+    return true;
 }
 
-void aiAsyncManager::queue(aiAsync **tasks, size_t num)
+int aiThreadPool::getThreadCount() const
 {
-    for (size_t i = 0; i < num; ++i)
-        tasks[i]->prepare();
+    return (int)m_workers.size();
+}
+
+void aiThreadPool::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(s_pool_config_mutex);
+        if (!s_pool_started)
+            return;
+    }
+    instance().stop();
+}
+
+void aiThreadPool::start(int n)
+{
+    if (n <= 0)
+        n = std::max<int>(std::thread::hardware_concurrency(), 1);
+
+    m_stop = false;
+    for (int i = 0; i < n; ++i)
+        m_workers.emplace_back(new Worker());
+    for (int i = 0; i < n; ++i)
+        m_workers[i]->thread = std::thread([this, i]() { process(i); });
+}
+
+void aiThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stop)
+            return;
+        m_stop = true;
+    }
+    m_cond.notify_all();
+
+    // workers leave when no task is pending. m_workers is kept because waiters may still be stealing from it
+    for (auto& w : m_workers) {
+        if (w->thread.joinable())
+            w->thread.join();
+    }
+}
+
+void aiThreadPool::enqueue(const Task& task)
+{
+    enqueue(Task(task));
+}
 
+void aiThreadPool::enqueue(Task&& task)
+{
+    // tasks spawned by a worker go to its own deque so that it picks them up first (cache friendly).
+    // others are distributed round robin.
+    bool queued = false;
     {
+        // m_mutex keeps stop() from letting the workers leave before this task is queued
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_tasks.insert(m_tasks.end(), tasks, tasks + num);
+        if (!m_stop) {
+            int n = (int)m_workers.size();
+            int wi = t_worker_index != -1 ? t_worker_index : (int)(m_next++ % (uint32_t)n);
+            {
+                auto& w = *m_workers[wi];
+                std::lock_guard<std::mutex> wlock(w.mutex);
+                w.tasks.push_back(std::move(task));
+            }
+            m_pending++;
+            queued = true;
+        }
+    }
+    if (!queued) {
+        // the pool has been shut down
+        task();
+        return;
+    }
+    m_cond.notify_one();
+}
+
+bool aiThreadPool::pop(int wi, Task& dst)
+{
+    auto& w = *m_workers[wi];
+    std::lock_guard<std::mutex> lock(w.mutex);
+    if (w.tasks.empty())
+        return false;
+
+    // LIFO for own tasks
+    dst = std::move(w.tasks.back());
+    w.tasks.pop_back();
+    m_pending--;
+    return true;
+}
 
-        // launch worker thread (task) if needed
-        if (!m_processing) {
-            m_processing = true;
-            m_future = std::async(std::launch::async, [this]() { process(); });
+bool aiThreadPool::steal(int wi, Task& dst)
+{
+    int n = (int)m_workers.size();
+    int begin = wi != -1 ? wi + 1 : 0;
+    for (int i = 0; i < n; ++i) {
+        auto& w = *m_workers[(begin + i) % n];
+        std::lock_guard<std::mutex> lock(w.mutex);
+        if (!w.tasks.empty()) {
+            // FIFO for stolen tasks
+            dst = std::move(w.tasks.front());
+            w.tasks.pop_front();
+            m_pending--;
+            return true;
         }
     }
+    return false;
+}
+
+bool aiThreadPool::processOne()
+{
+    Task task;
+    int wi = t_worker_index;
+    if ((wi != -1 && pop(wi, task)) || steal(wi, task)) {
+        task();
+        return true;
+    }
+    return false;
 }
 
-void aiAsyncManager::process()
+void aiThreadPool::process(int wi)
 {
+    t_worker_index = wi;
+
+    Task task;
     while (true) {
-        aiAsync *task = nullptr;
-        {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            if (!m_tasks.empty()) {
-                task = m_tasks.front();
-                m_tasks.pop_front();
-            }
-            else {
-                m_processing = false;
-            }
+        if (pop(wi, task) || steal(wi, task)) {
+            task();
+            task = {};
+            continue;
         }
 
-        if (task)
-            task->run();
-        else
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this] { return m_stop || m_pending > 0; });
+        if (m_stop && m_pending == 0)
             break;
     }
 }
 
 
+aiTaskGroup::~aiTaskGroup()
+{
+    wait();
+}
+
+void aiTaskGroup::wait()
+{
+    while (m_active > 0) {
+        if (!aiThreadPool::instance().processOne()) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notify_completed.wait(lock, [this] { return m_active == 0; });
+        }
+    }
+    // make sure release() has left the lock before this can be destroyed
+    std::lock_guard<std::mutex> lock(m_mutex);
+}
+
+void aiTaskGroup::release()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--m_active == 0)
+        m_notify_completed.notify_all();
+}
+
+
+aiAsyncManager& aiAsyncManager::instance()
+{
+    static aiAsyncManager s_instance;
+    return s_instance;
+}
+
+void aiAsyncManager::queue(aiAsync *task)
+{
+    queue(&task, 1);
+}
+
+void aiAsyncManager::queue(aiAsync **tasks, size_t num)
+{
+    for (size_t i = 0; i < num; ++i)
+        tasks[i]->prepare();
+
+    auto& pool = aiThreadPool::instance();
+    for (size_t i = 0; i < num; ++i) {
+        auto *task = tasks[i];
+        pool.enqueue([task]() { task->run(); });
+    }
+}
+
+
 aiAsyncLoad::~aiAsyncLoad()
 {
-    if (m_async_cook.valid())
-        m_async_cook.wait();
+    wait();
 }
 
 void aiAsyncLoad::reset()
@@ -83,34 +244,23 @@ void aiAsyncLoad::prepare()
 
 void aiAsyncLoad::run()
 {
+    // read and cook run back to back on the same worker. parallelism comes from running many of these at once.
     if (m_read)
         m_read();
-
-    if (m_cook) {
-        m_async_cook = std::async(std::launch::async, [this]() {
-            m_cook();
-            release();
-        });
-    }
-    else {
-        release();
-    }
+    if (m_cook)
+        m_cook();
+    release();
 }
 
 void aiAsyncLoad::release()
 {
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_completed = true;
-    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_completed = true;
     m_notify_completed.notify_all();
 }
 
 void aiAsyncLoad::wait()
 {
-    if (!m_completed) {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_notify_completed.wait(lock, [this] { return m_completed; });
-    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_notify_completed.wait(lock, [this] { return m_completed; });
 }
-
@@ -1,5 +1,79 @@
 #pragma once
 
+// persistent pool of worker threads. each worker has its own task deque and steals from others when it runs dry.
+class aiThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    static aiThreadPool& instance();
+
+    // 0: one worker per hardware thread. the pool is shared by all contexts and sized once on first use,
+    // so this takes effect only if called before that. returns false if the pool is already running.
+    static bool setThreadCount(int n);
+    int getThreadCount() const;
+    // joins the workers after they finish pending tasks. tasks enqueued after this run on the calling thread.
+    // must be called before the module is unloaded (see aiCleanup()). the pool is never destroyed otherwise.
+    static void shutdown();
+
+    void enqueue(const Task& task);
+    void enqueue(Task&& task);
+
+    // execute one pending task on the calling thread if any. returns false if nothing was done.
+    // waiters use this to help instead of just blocking.
+    bool processOne();
+
+private:
+    struct Worker
+    {
+        std::deque<Task> tasks;
+        std::mutex mutex;
+        std::thread thread;
+    };
+    using WorkerPtr = std::unique_ptr<Worker>;
+
+    aiThreadPool();
+    void start(int n);
+    void stop();
+    void process(int wi);
+    bool pop(int wi, Task& dst);
+    bool steal(int wi, Task& dst);
+
+    std::vector<WorkerPtr> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::atomic<int> m_pending{ 0 };
+    std::atomic<uint32_t> m_next{ 0 };
+    bool m_stop = false;
+};
+
+
+// counts tasks queued to aiThreadPool and waits for all of them
+class aiTaskGroup
+{
+public:
+    ~aiTaskGroup();
+
+    template<class Body>
+    void run(const Body& body)
+    {
+        m_active++;
+        aiThreadPool::instance().enqueue([this, body]() {
+            body();
+            release();
+        });
+    }
+    void wait();
+
+private:
+    void release();
+
+    std::atomic<int> m_active{ 0 };
+    std::mutex m_mutex;
+    std::condition_variable m_notify_completed;
+};
+
+
 class aiAsync
 {
 public:
@@ -15,15 +89,6 @@ public:
     static aiAsyncManager& instance();
     void queue(aiAsync *task);
     void queue(aiAsync **tasks, size_t num);
-
-private:
-    ~aiAsyncManager();
-    void process();
-
-    std::deque<aiAsync*> m_tasks;
-    std::mutex m_mutex;
-    std::future<void> m_future;
-    bool m_processing = false;
 };
 
 
@@ -43,11 +108,8 @@ public:
 private:
     void release();
 
-    std::future<void> m_async_cook;
-    // these are needed because m_async_cook possibly has not started yet when wait() is called
+    // these are needed because the task possibly has not started yet when wait() is called
     std::mutex m_mutex;
     std::condition_variable m_notify_completed;
     bool m_completed = true;
 };
-
-
@@ -22,19 +22,28 @@ aiCamera::aiCamera(aiObject *parent, const abcObject &abc)
 {
 }
 
+aiCamera::~aiCamera()
+{
+    waitAsync();
+    waitPrefetch();
+}
+
 aiCamera::Sample* aiCamera::newSample()
 {
     return new Sample(this);
 }
 
-void aiCamera::readSampleBody(Sample& sample, uint64_t idx)
+void aiCamera::readSampleBody(Sample& sample, uint64_t idx, bool force_update)
 {
     auto ss = aiIndexToSampleSelector(idx);
-    auto ss2 = aiIndexToSampleSelector(idx + 1);
 
     readVisibility(sample, ss);
-    m_schema.get(sample.cam_sp, ss);
-    m_schema.get(sample.cam_sp2, ss2);
+    if (canTakeSecondSample(sample, idx, force_update))
+        sample.cam_sp = sample.cam_sp2;
+    else
+        m_schema.get(sample.cam_sp, ss);
+    sample.m_sample_index = idx;
+    sample.m_sample_index2 = -1;
 }
 
 void aiCamera::cookSampleBody(Sample& sample)
@@ -62,6 +71,11 @@ void aiCamera::cookSampleBody(Sample& sample)
     dst.aspect_ratio = float(sp.getHorizontalAperture() / vertical_aperture);
 
     if (config.interpolate_samples && m_current_time_offset != 0) {
+        if (needsSecondSample(sample)) {
+            m_schema.get(sample.cam_sp2, aiIndexToSampleSelector(sample.m_sample_index + 1));
+            sample.m_sample_index2 = sample.m_sample_index + 1;
+        }
+
         auto& sp2 = sample.cam_sp2;
         float time_offset = (float)m_current_time_offset;
         float focal_length2 = (float)sp2.getFocalLength();
@@ -26,8 +26,9 @@ class aiCamera : public aiTSchema<aiCameraTraits>
 using super = aiTSchema<aiCameraTraits>;
 public:
     aiCamera(aiObject *parent, const abcObject &abc);
+    ~aiCamera() override;
 
     Sample* newSample() override;
-    void readSampleBody(Sample& sample, uint64_t idx) override;
+    void readSampleBody(Sample& sample, uint64_t idx, bool force_update) override;
     void cookSampleBody(Sample& sample) override;
 };
@@ -2,7 +2,12 @@
 #include "aiInternal.h"
 #include "aiContext.h"
 #include "aiObject.h"
+#include "aiSchema.h"
 #include "aiAsync.h"
+#include "aiXForm.h"
+#include "aiPolyMesh.h"
+#include "aiCamera.h"
+#include "aiPoints.h"
 
 
 static std::wstring L(const std::string& s)
@@ -40,6 +45,127 @@ static std::string NormalizePath(const char *in_path)
 }
 
 
+static void SplitPath(std::vector<std::string>& dst, const std::string& path, char separator)
+{
+    dst.clear();
+    size_t pos = 0;
+    while (pos <= path.size()) {
+        size_t next = path.find(separator, pos);
+        if (next == std::string::npos)
+            next = path.size();
+        if (next > pos)
+            dst.push_back(path.substr(pos, next - pos));
+        pos = next + 1;
+    }
+}
+
+// '*': any characters, '?': any one character
+static bool MatchGlob(const char *pattern, const char *str)
+{
+    for (; *pattern; ++pattern, ++str) {
+        if (*pattern == '*') {
+            for (; *str; ++str) {
+                if (MatchGlob(pattern + 1, str))
+                    return true;
+            }
+            return MatchGlob(pattern + 1, str);
+        }
+        if (*str == '\0' || (*pattern != '?' && *pattern != *str))
+            return false;
+    }
+    return *str == '\0';
+}
+
+
+std::mutex aiArchive::s_mutex;
+std::map<std::string, std::weak_ptr<aiArchive>> aiArchive::s_archives;
+
+aiArchivePtr aiArchive::open(const std::string& path, const char *in_path)
+{
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        auto it = s_archives.find(path);
+        if (it != s_archives.end()) {
+            if (auto ret = it->second.lock()) {
+                DebugLog("Sharing already opened archive");
+                return ret;
+            }
+        }
+    }
+
+    // opened without the lock. the destructor takes it
+    auto wpath = L(in_path);
+    aiArchivePtr ret(new aiArchive());
+    ret->m_path = path;
+    try {
+        if (ret->m_mapped.open(in_path)) {
+            // Ogawa picks a free stream for each read. give one per worker thread (+ main thread) so that
+            // parallel updates don't serialize on a single stream. all of them read the same mapped region.
+            int num_streams = aiThreadPool::instance().getThreadCount() + 1;
+            for (int i = 0; i < num_streams; ++i)
+                ret->m_streams.push_back(new MemoryStream(ret->m_mapped.data(), ret->m_mapped.size()));
+        }
+        else {
+            // Abc::IArchive doesn't accept wide string path. so create file stream with wide string path and pass it.
+            // (VisualC++'s std::ifstream accepts wide string)
+            ret->m_streams.push_back(
+#ifdef WIN32
+                new std::ifstream(wpath.c_str(), std::ios::in | std::ios::binary)
+#elif __linux__
+                new std::ifstream(in_path, std::ios::in | std::ios::binary)
+#else
+                new std::ifstream(path.c_str(), std::ios::in | std::ios::binary)
+#endif
+            );
+        }
+
+        Alembic::AbcCoreOgawa::ReadArchive archive_reader(ret->m_streams);
+        ret->m_archive = Abc::IArchive(archive_reader(path), Abc::kWrapExisting, Abc::ErrorHandler::kThrowPolicy);
+        DebugLog("Successfully opened Ogawa archive");
+    }
+    catch (Alembic::Util::Exception e) {
+        // HDF5 archive doesn't accept external stream. so close it.
+        // (that means if path contains wide characters, it can't be opened. I couldn't find solution..)
+        for (auto s : ret->m_streams) { delete s; }
+        ret->m_streams.clear();
+        ret->m_mapped.close();
+
+        try {
+            ret->m_archive = Abc::IArchive(AbcCoreHDF5::ReadArchive(), path);
+            DebugLog("Successfully opened HDF5 archive");
+        }
+        catch (Alembic::Util::Exception e2) {
+            auto message = L(e2.what());
+            DebugLogW(L"Failed to open archive: %s", message.c_str());
+        }
+    }
+
+    if (!ret->m_archive.valid())
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_archives[path] = ret;
+    return ret;
+}
+
+aiArchive::~aiArchive()
+{
+    m_archive.reset();
+    for (auto s : m_streams) { delete s; }
+    m_streams.clear();
+    m_mapped.close();
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    auto it = s_archives.find(m_path);
+    if (it != s_archives.end() && it->second.expired())
+        s_archives.erase(it);
+}
+
+Abc::IArchive aiArchive::get() const
+{
+    return m_archive;
+}
+
 
 aiContextManager aiContextManager::s_instance;
 
@@ -96,6 +222,7 @@ aiContext::aiContext(int uid)
 
 aiContext::~aiContext()
 {
+    waitLoad();
     reset();
 }
 
@@ -106,22 +233,27 @@ Abc::IArchive aiContext::getArchive() const
 
 const std::string& aiContext::getPath() const
 {
+    // loadBody() writes m_path on the thread of loadAsync()
+    waitLoad();
     return m_path;
 }
 
 
 int aiContext::getTimeSamplingCount() const
 {
+    waitLoad();
     return (int)m_timesamplings.size();
 }
 
 aiTimeSampling * aiContext::getTimeSampling(int i)
 {
+    waitLoad();
     return m_timesamplings[i].get();
 }
 
 void aiContext::getTimeRange(double& begin, double& end) const
 {
+    waitLoad();
     begin = end = 0.0;
     for (size_t i = 1; i < m_timesamplings.size(); ++i) {
         double tmp_begin, tmp_end;
@@ -140,6 +272,7 @@ void aiContext::getTimeRange(double& begin, double& end) const
 
 int aiContext::getTimeSamplingCount()
 {
+    waitLoad();
     return (int)m_timesamplings.size();
 }
 
@@ -167,117 +300,273 @@ const aiConfig& aiContext::getConfig() const
 
 void aiContext::setConfig(const aiConfig &config)
 {
+    waitLoad();
     m_config = config;
+    m_sample_cache.setBudget((size_t)std::max<int64_t>(config.sample_cache_budget, 0));
 }
 
-void aiContext::gatherNodesRecursive(aiObject *n)
+std::string aiContext::getSharingKey() const
 {
-    auto& abc = n->getAbcObject();
-    size_t num_children = abc.getNumChildren();
+    auto& c = m_config;
+    char buf[256];
+    snprintf(buf, sizeof(buf), "|%d|%d|%f|%d|%d|%d|%d|%d|%d|%d",
+        (int)c.normals_mode, (int)c.tangents_mode, c.scale_factor, c.split_unit,
+        (int)c.swap_handedness, (int)c.swap_face_winding, (int)c.interpolate_samples,
+        (int)c.import_point_polygon, (int)c.import_line_polygon, (int)c.import_triangle_polygon);
+    return m_path + buf;
+}
 
-    for (size_t i = 0; i < num_children; ++i) {
-        auto *child = n->newChild(abc.getChild(i));
-        gatherNodesRecursive(child);
-    }
+aiSampleCache& aiContext::getSampleCache()
+{
+    return m_sample_cache;
+}
+
+void aiContext::gatherNodesRecursive(aiObject *n)
+{
+    n->createChildren();
+    n->eachChild([](aiObject& child) {
+        gatherNodesRecursive(&child);
+    });
 }
 
 void aiContext::reset()
 {
     waitAsync();
     m_top_node.reset();
+    m_sample_cache.clear();
     m_timesamplings.clear();
     m_archive.reset();
+    m_shared_archive.reset();
 
     m_path.clear();
-    for (auto s : m_streams) { delete s; }
-    m_streams.clear();
+    m_filter.clear();
+    m_filter_paths.clear();
 
     // m_config is not reset intentionally
 }
 
-bool aiContext::load(const char *in_path)
+bool aiContext::isLoaded(const std::string& path, const std::string& filter) const
 {
+    return path == m_path && filter == m_filter && m_archive;
+}
+
+bool aiContext::load(const char *in_path, const char *filter)
+{
+    waitLoad();
+
     auto path = NormalizePath(in_path);
-    auto wpath = L(in_path);
+    std::string filter_str = filter ? filter : "";
+    if (isLoaded(path, filter_str)) {
+        DebugLog("Context already loaded for gameObject with id %d", m_uid);
+        return true;
+    }
+    return loadBody(in_path ? in_path : "", filter_str);
+}
 
-    DebugLogW(L"aiContext::load: '%s'", wpath.c_str());
-    if (path == m_path && m_archive) {
+bool aiContext::loadAsync(const char *in_path, const char *filter)
+{
+    waitLoad();
+
+    auto path = NormalizePath(in_path);
+    std::string filter_str = filter ? filter : "";
+    if (isLoaded(path, filter_str)) {
         DebugLog("Context already loaded for gameObject with id %d", m_uid);
         return true;
     }
+    if (path.empty()) {
+        reset();
+        m_load_state = (int)aiLoadState::Failed;
+        return false;
+    }
+
+    m_load_state = (int)aiLoadState::Loading;
+    m_load_progress = 0.0f;
+    std::string in_path_str = in_path;
+    std::lock_guard<std::mutex> lock(m_load_mutex);
+    m_load_task = std::async(std::launch::async, [this, in_path_str, filter_str]() {
+        loadBody(in_path_str, filter_str);
+    }).share();
+    return true;
+}
 
+bool aiContext::waitLoad() const
+{
+    std::shared_future<void> task;
+    {
+        std::lock_guard<std::mutex> lock(m_load_mutex);
+        task = m_load_task;
+    }
+    if (task.valid())
+        task.wait();
+    return m_load_state == (int)aiLoadState::Succeeded;
+}
+
+aiLoadState aiContext::getLoadState() const
+{
+    return (aiLoadState)m_load_state.load();
+}
+
+float aiContext::getLoadProgress() const
+{
+    return m_load_progress;
+}
+
+bool aiContext::loadBody(const std::string& in_path, const std::string& filter)
+{
+    auto path = NormalizePath(in_path.c_str());
+    auto wpath = L(in_path);
+    DebugLogW(L"aiContext::load: '%s'", wpath.c_str());
+
+    m_load_state = (int)aiLoadState::Loading;
+    m_load_progress = 0.0f;
     reset();
     if (path.empty()) {
+        m_load_state = (int)aiLoadState::Failed;
         return false;
     }
 
     m_path = path;
-    if (!m_archive.valid()) {
-        try {
-            // Abc::IArchive doesn't accept wide string path. so create file stream with wide string path and pass it.
-            // (VisualC++'s std::ifstream accepts wide string)
-            m_streams.push_back(
-#ifdef WIN32
-                new std::ifstream(wpath.c_str(), std::ios::in | std::ios::binary)
-#elif __linux__
-                new std::ifstream(in_path, std::ios::in | std::ios::binary)
-#else
-                new std::ifstream(path.c_str(), std::ios::in | std::ios::binary)
-#endif
-            );
-
-            Alembic::AbcCoreOgawa::ReadArchive archive_reader(m_streams);
-            m_archive = Abc::IArchive(archive_reader(m_path), Abc::kWrapExisting, Abc::ErrorHandler::kThrowPolicy);
-            DebugLog("Successfully opened Ogawa archive");
+    m_filter = filter;
+    {
+        std::vector<std::string> patterns;
+        SplitPath(patterns, m_filter, ';');
+        for (auto& pattern : patterns) {
+            m_filter_paths.emplace_back();
+            SplitPath(m_filter_paths.back(), pattern, '/');
         }
-        catch (Alembic::Util::Exception e) {
-            // HDF5 archive doesn't accept external stream. so close it.
-            // (that means if path contains wide characters, it can't be opened. I couldn't find solution..)
-            for (auto s : m_streams) { delete s; }
-            m_streams.clear();
-
-            try {
-                m_archive = Abc::IArchive(AbcCoreHDF5::ReadArchive(), path);
-                DebugLog("Successfully opened HDF5 archive");
-            }
-            catch (Alembic::Util::Exception e2) {
-                auto message = L(e2.what());
-                DebugLogW(L"Failed to open archive: %s", message.c_str());
+    }
+
+    // rough weights of each step: opening the archive, time samplings (which count samples of all schemas), tree
+    // exceptions must not escape. this may run on the thread of loadAsync() and is called through the C API.
+    try {
+        m_shared_archive = aiArchive::open(path, in_path.c_str());
+        if (m_shared_archive)
+            m_archive = m_shared_archive->get();
+        m_load_progress = 0.3f;
+
+        if (m_archive.valid()) {
+            m_timesamplings.clear();
+            auto num_time_samplings = (int)m_archive.getNumTimeSamplings();
+            for (int i = 0; i < num_time_samplings; ++i) {
+                m_timesamplings.emplace_back(aiCreateTimeSampling(m_archive, i));
+                m_load_progress = 0.3f + 0.4f * float(i + 1) / float(num_time_samplings);
             }
+
+            abcObject abc_top = m_archive.getTop();
+            m_top_node.reset(new aiObject(this, nullptr, abc_top));
+            m_load_progress = 0.8f;
+            // otherwise nodes are created on demand
+            if (m_config.eager_load)
+                gatherNodesRecursive(m_top_node.get());
+
+            m_load_progress = 1.0f;
+            m_load_state = (int)aiLoadState::Succeeded;
+            return true;
         }
     }
-    else {
-        DebugLogW(L"Archive '%s' already opened", wpath.c_str());
+    catch (const std::exception& e) {
+        auto message = L(e.what());
+        DebugLogW(L"Failed to load archive: %s", message.c_str());
     }
 
-    if (m_archive.valid()) {
-        abcObject abc_top = m_archive.getTop();
-        m_top_node.reset(new aiObject(this, nullptr, abc_top));
-        gatherNodesRecursive(m_top_node.get());
+    reset();
+    m_load_progress = 1.0f;
+    m_load_state = (int)aiLoadState::Failed;
+    return false;
+}
 
-        m_timesamplings.clear();
-        auto num_time_samplings = (int)m_archive.getNumTimeSamplings();
-        for (int i = 0; i < num_time_samplings; ++i) {
-            m_timesamplings.emplace_back(aiCreateTimeSampling(m_archive, i));
-        }
+bool aiContext::isPathAccepted(const std::string& fullname) const
+{
+    if (m_filter_paths.empty())
         return true;
+
+    std::vector<std::string> elements;
+    SplitPath(elements, fullname, '/');
+    for (auto& filter : m_filter_paths) {
+        // the node is accepted if it is a descendant of a matched node or an ancestor of possible matches
+        size_t n = std::min(elements.size(), filter.size());
+        size_t i = 0;
+        while (i < n && MatchGlob(filter[i].c_str(), elements[i].c_str()))
+            ++i;
+        if (i == n)
+            return true;
     }
-    else {
-        reset();
-        return false;
-    }
+    return false;
 }
 
 aiObject* aiContext::getTopObject() const
 {
+    waitLoad();
     return m_top_node.get();
 }
 
+void aiContext::getHierarchySummary(aiHierarchySummary& dst)
+{
+    // names are only counted. children are created as a side effect, so getHierarchy() walks the same tree.
+    int index = 0, name_offset = 0;
+    if (auto *top = getTopObject())
+        getHierarchyRecursive(top, -1, aiHierarchyData(), index, name_offset);
+    dst.node_count = index;
+    dst.name_buffer_size = name_offset;
+}
+
+void aiContext::getHierarchy(const aiHierarchyData& dst)
+{
+    int index = 0, name_offset = 0;
+    if (auto *top = getTopObject())
+        getHierarchyRecursive(top, -1, dst, index, name_offset);
+}
+
+void aiContext::getHierarchyRecursive(aiObject *n, int parent, const aiHierarchyData& dst, int& index, int& name_offset)
+{
+    int self = index++;
+    auto *schema = dynamic_cast<aiSchema*>(n);
+    if (dst.objects)
+        dst.objects[self] = n;
+    if (dst.parent_indices)
+        dst.parent_indices[self] = parent;
+    if (dst.schema_types) {
+        auto type = aiSchemaType::None;
+        if (dynamic_cast<aiXform*>(n))
+            type = aiSchemaType::Xform;
+        else if (dynamic_cast<aiCamera*>(n))
+            type = aiSchemaType::Camera;
+        else if (dynamic_cast<aiPolyMesh*>(n))
+            type = aiSchemaType::PolyMesh;
+        else if (dynamic_cast<aiPoints*>(n))
+            type = aiSchemaType::Points;
+        dst.schema_types[self] = type;
+    }
+    if (dst.time_sampling_indices)
+        dst.time_sampling_indices[self] = schema ? schema->getTimeSamplingIndex() : 0;
+    if (dst.constant_flags)
+        dst.constant_flags[self] = schema ? schema->isConstant() : true;
+
+    const char *name = n->getName();
+    int name_size = (int)strlen(name) + 1;
+    if (dst.name_offsets)
+        dst.name_offsets[self] = name_offset;
+    if (dst.names)
+        memcpy(dst.names + name_offset, name, name_size);
+    name_offset += name_size;
+
+    int num_children = (int)n->getNumChildren();
+    for (int i = 0; i < num_children; ++i)
+        getHierarchyRecursive(n->getChild(i), self, dst, index, name_offset);
+}
+
 void aiContext::updateSamples(double time)
 {
+    waitLoad();
     waitAsync();
 
     auto ss = aiTimeToSampleSelector(time);
+    updateCullingMatrices(ss);
+    if (m_config.parallel_update) {
+        updateSamplesParallel(ss);
+        return;
+    }
+
     eachNodes([ss](aiObject& o) {
         o.updateSample(ss);
     });
@@ -288,6 +577,105 @@ void aiContext::updateSamples(double time)
     }
 }
 
+void aiContext::setViewFrustums(const aiFrustum *frustums, int count)
+{
+    if (frustums && count > 0)
+        m_view_frustums.assign(frustums, frustums + count);
+    else
+        m_view_frustums.clear();
+}
+
+const std::vector<aiFrustum>& aiContext::getViewFrustums() const
+{
+    return m_view_frustums;
+}
+
+static void UpdateCullingMatricesRecursive(aiObject& obj, const abcM44d& parent, const abcSampleSelector& ss)
+{
+    abcM44d matrix = parent;
+    if (auto *xf = dynamic_cast<aiXform*>(&obj))
+        matrix = xf->getWorldMatrix(ss, parent);
+    else if (auto *schema = dynamic_cast<aiSchema*>(&obj))
+        schema->setCullingMatrix(parent);
+    obj.eachChild([&matrix, &ss](aiObject& c) {
+        UpdateCullingMatricesRecursive(c, matrix, ss);
+    });
+}
+
+// place the objects in the space of the top object with the xforms at ss. the top object has no transform.
+void aiContext::updateCullingMatrices(const abcSampleSelector& ss)
+{
+    if (m_view_frustums.empty() || !m_top_node)
+        return;
+    abcM44d identity;
+    m_top_node->eachChild([&identity, &ss](aiObject& c) {
+        UpdateCullingMatricesRecursive(c, identity, ss);
+    });
+}
+
+void aiContext::updateSamplesParallel(const abcSampleSelector& ss)
+{
+    // schemas don't share sample state, so each one can read and cook on its own worker.
+    m_update_targets.clear();
+    eachNodes([this](aiObject& o) {
+        if (dynamic_cast<aiSchema*>(&o))
+            m_update_targets.push_back(&o);
+    });
+
+    aiTaskGroup group;
+    for (auto *o : m_update_targets)
+        group.run([o, ss]() { o->updateSample(ss); });
+    group.wait();
+}
+
+void aiContext::bakeRange(double begin, double end)
+{
+    waitLoad();
+    waitAsync();
+
+    auto ss_begin = aiTimeToSampleSelector(begin);
+    auto ss_end = aiTimeToSampleSelector(end);
+    m_update_targets.clear();
+    eachNodes([this](aiObject& o) {
+        if (dynamic_cast<aiSchema*>(&o))
+            m_update_targets.push_back(&o);
+    });
+
+    aiTaskGroup group;
+    for (auto *o : m_update_targets) {
+        auto *schema = static_cast<aiSchema*>(o);
+        if (end < begin)
+            group.run([schema]() { schema->clearBake(); });
+        else
+            group.run([schema, ss_begin, ss_end]() { schema->bakeRange(ss_begin, ss_end); });
+    }
+    group.wait();
+}
+
+void aiContext::updateAndFillPolyMeshes(double time, const aiPolyMeshBatchRecord *records, int count, aiPolyMeshBatchResult *dst)
+{
+    waitLoad();
+    waitAsync();
+
+    // records are grouped to keep task overhead small relative to tiny meshes
+    const int grain = 16;
+    auto ss = aiTimeToSampleSelector(time);
+    updateCullingMatrices(ss);
+    aiTaskGroup group;
+    for (int begin = 0; begin < count; begin += grain) {
+        int end = std::min(begin + grain, count);
+        group.run([ss, records, dst, begin, end]() {
+            for (int i = begin; i < end; ++i) {
+                if (records[i].schema)
+                    records[i].schema->updateAndFill(ss, records[i], dst[i]);
+                else
+                    dst[i] = aiPolyMeshBatchResult();
+            }
+        });
+    }
+    group.wait();
+}
+
 void aiContext::queueAsync(aiAsync& task)
 {
     m_async_tasks.push_back(&task);
@@ -1,4 +1,6 @@
 #pragma once
+#include "aiMappedFile.h"
+
 using abcObject = AbcGeom::IObject;
 using abcXform = AbcGeom::IXform;
 using abcCamera = AbcGeom::ICamera;
@@ -28,6 +30,29 @@ class aiObject;
 class aiAsync;
 
 #include "aiTimeSampling.h"
+#include "aiSampleCache.h"
+
+
+// opened archive and its streams. shared by all contexts that load the same path.
+class aiArchive
+{
+public:
+    static std::shared_ptr<aiArchive> open(const std::string& path, const char *in_path);
+    ~aiArchive();
+    Abc::IArchive get() const;
+
+private:
+    aiArchive() {}
+
+    static std::mutex s_mutex;
+    static std::map<std::string, std::weak_ptr<aiArchive>> s_archives;
+
+    std::string m_path;
+    Abc::IArchive m_archive;
+    MappedFile m_mapped; // must outlive m_streams
+    std::vector<std::istream*> m_streams;
+};
+using aiArchivePtr = std::shared_ptr<aiArchive>;
 
 
 class aiContextManager
@@ -52,13 +77,28 @@ public:
     explicit aiContext(int uid=-1);
     ~aiContext();
 
-    bool load(const char *path);
+    bool load(const char *path, const char *filter = nullptr);
+    // open on a background thread. returns false if path is empty.
+    // entry points that touch the archive (getTopObject(), updateSamples(), etc.) wait for it to complete.
+    bool loadAsync(const char *path, const char *filter = nullptr);
+    bool waitLoad() const;
+    aiLoadState getLoadState() const;
+    float getLoadProgress() const;
+    bool isPathAccepted(const std::string& fullname) const;
 
     const aiConfig& getConfig() const;
     void setConfig(const aiConfig &config);
+    // contexts with the same key produce the same cooked data and can share it
+    std::string getSharingKey() const;
 
     aiObject* getTopObject() const;
+    void getHierarchySummary(aiHierarchySummary& dst);
+    void getHierarchy(const aiHierarchyData& dst);
     void updateSamples(double time);
+    void setViewFrustums(const aiFrustum *frustums, int count);
+    const std::vector<aiFrustum>& getViewFrustums() const;
+    void bakeRange(double begin, double end);
+    void updateAndFillPolyMeshes(double time, const aiPolyMeshBatchRecord *records, int count, aiPolyMeshBatchResult *dst);
 
     Abc::IArchive getArchive() const;
     const std::string& getPath() const;
@@ -71,6 +111,8 @@ public:
     int getTimeSamplingCount();
     int getTimeSamplingIndex(Abc::TimeSamplingPtr ts);
 
+    aiSampleCache& getSampleCache();
+
     void queueAsync(aiAsync& task);
     void waitAsync();
 
@@ -79,18 +121,33 @@ public:
 
 private:
     static void gatherNodesRecursive(aiObject *n);
+    static void getHierarchyRecursive(aiObject *n, int parent, const aiHierarchyData& dst, int& index, int& name_offset);
+    bool isLoaded(const std::string& path, const std::string& filter) const;
+    bool loadBody(const std::string& in_path, const std::string& filter);
     void reset();
+    void updateSamplesParallel(const abcSampleSelector& ss);
+    void updateCullingMatrices(const abcSampleSelector& ss);
 
     std::string m_path;
-    std::vector<std::istream*> m_streams;
-
+    std::string m_filter;
+    std::vector<std::vector<std::string>> m_filter_paths; // split into path elements
+    aiArchivePtr m_shared_archive;
     Abc::IArchive m_archive;
     std::unique_ptr<aiObject> m_top_node;
     std::vector<aiTimeSamplingPtr> m_timesamplings;
     int m_uid = 0;
     aiConfig m_config;
+    aiSampleCache m_sample_cache;
+    std::vector<aiFrustum> m_view_frustums;
 
     std::vector<aiAsync*> m_async_tasks;
+    std::vector<aiObject*> m_update_targets;
+
+    // shared so that any number of threads can wait for it. m_load_mutex guards the handle, not the load
+    std::shared_future<void> m_load_task;
+    mutable std::mutex m_load_mutex;
+    std::atomic<int> m_load_state{ (int)aiLoadState::None };
+    std::atomic<float> m_load_progress{ 0.0f };
 };
 
 #include "aiObject.h"
@@ -91,6 +91,21 @@ aiObject* aiObject::newChild(const abcObject &abc)
     return ret;
 }
 
+void aiObject::createChildren()
+{
+    if (m_children_created)
+        return;
+    m_children_created = true;
+
+    // nodes rejected by the path filter are not even opened
+    size_t num_children = m_abc.getNumChildren();
+    m_children.reserve(num_children);
+    for (size_t i = 0; i < num_children; ++i) {
+        if (m_ctx->isPathAccepted(m_abc.getChildHeader(i).getFullName()))
+            newChild(m_abc.getChild(i));
+    }
+}
+
 void aiObject::removeChild(aiObject *c)
 {
     if (c == nullptr) { return; }
@@ -108,8 +123,8 @@ const aiConfig& aiObject::getConfig() const { return m_ctx->getConfig(); }
 abcObject&  aiObject::getAbcObject()        { return m_abc; }
 const char* aiObject::getName() const       { return m_name.c_str(); }
 const char* aiObject::getFullName() const   { return m_fullname.c_str(); }
-uint32_t    aiObject::getNumChildren() const{ return (uint32_t)m_children.size(); }
-aiObject*   aiObject::getChild(int i)       { return m_children[i].get(); }
+uint32_t    aiObject::getNumChildren()      { createChildren(); return (uint32_t)m_children.size(); }
+aiObject*   aiObject::getChild(int i)       { createChildren(); return m_children[i].get(); }
 aiObject*   aiObject::getParent() const     { return m_parent; }
 void        aiObject::setEnabled(bool v)    { m_enabled = v; }
 
@@ -14,7 +14,7 @@ public:
 
     const char* getName() const;
     const char* getFullName() const;
-    uint32_t    getNumChildren() const;
+    uint32_t    getNumChildren();
     aiObject*   getChild(int i);
     aiObject*   getParent() const;
     void        setEnabled(bool v);
@@ -24,6 +24,8 @@ public:
     virtual void waitAsync();
 
 
+    // children are created on first access of getNumChildren() / getChild() unless aiConfig::eager_load is set.
+    // eachChild() and eachChildRecursive() visit only created ones.
     template<class F>
     void eachChild(const F &f)
     {
@@ -45,6 +47,7 @@ public:
     const aiConfig& getConfig() const;
     abcObject&  getAbcObject();
     aiObject*   newChild(const abcObject &abc);
+    void        createChildren();
     void        removeChild(aiObject *c);
 
 protected:
@@ -57,6 +60,7 @@ protected:
     abcObject   m_abc;
     aiObject    *m_parent = nullptr;
     std::vector<ObjectPtr> m_children;
+    bool m_children_created = false;
     std::string m_name;     //
     std::string m_fullname; // sanitized
     bool m_enabled = true;
@@ -69,7 +69,7 @@ void aiPointsSample::fillData(aiPointsData &data)
     if (m_force_sync || !getConfig().async_load)
         body();
     else
-        m_async_copy = std::async(std::launch::async, body);
+        m_async_copy.run(body);
 }
 
 void aiPointsSample::getSummary(aiPointsSampleSummary & dst)
@@ -79,8 +79,7 @@ void aiPointsSample::getSummary(aiPointsSampleSummary & dst)
 
 void aiPointsSample::waitAsync()
 {
-    if (m_async_copy.valid())
-        m_async_copy.wait();
+    m_async_copy.wait();
     m_force_sync = false;
 }
 
@@ -94,6 +93,7 @@ aiPoints::aiPoints(aiObject *parent, const abcObject &abc)
 aiPoints::~aiPoints()
 {
     waitAsync();
+    waitPrefetch();
 }
 
 void aiPoints::updateSummary()
@@ -131,22 +131,22 @@ aiPoints::Sample* aiPoints::newSample()
     return new Sample(this);
 }
 
-void aiPoints::readSampleBody(Sample & sample, uint64_t idx)
+void aiPoints::readSampleBody(Sample & sample, uint64_t idx, bool force_update)
 {
     auto ss = aiIndexToSampleSelector(idx);
-    auto ss2 = aiIndexToSampleSelector(idx + 1);
-    auto& summary = getSummary();
 
     readVisibility(sample, ss);
 
     // points
     if (m_summary.has_points) {
-        auto prop = m_schema.getPositionsProperty();
-        prop.get(sample.m_points_sp, ss);
-        if (summary.interpolate_points) {
-            prop.get(sample.m_points_sp2, ss2);
-        }
+        if (canTakeSecondSample(sample, idx, force_update) && sample.m_points_sp2)
+            sample.m_points_sp.swap(sample.m_points_sp2);
+        else
+            m_schema.getPositionsProperty().get(sample.m_points_sp, ss);
     }
+    sample.m_points_sp2.reset();
+    sample.m_sample_index = idx;
+    sample.m_sample_index2 = -1;
 
     // velocities
     sample.m_velocities_sp.reset();
@@ -170,7 +170,17 @@ void aiPoints::cookSampleBody(Sample& sample)
         return;
 
     int point_count = (int)sample.m_points_sp->size();
+    bool read2 = summary.interpolate_points && needsSecondSample(sample);
+    if (read2) {
+        m_schema.getPositionsProperty().get(sample.m_points_sp2, aiIndexToSampleSelector(sample.m_sample_index + 1));
+        sample.m_sample_index2 = sample.m_sample_index + 1;
+    }
+    // m_points2 is valid only if the second sample is read. the interpolation is the first one itself without it
+    bool has2 = summary.interpolate_points && hasSecondSample(sample) && sample.m_points_sp2;
+    // set if m_points2 and m_points_int were written along with m_points
+    bool points_lerped = false;
     if (m_sample_index_changed) {
+        const int *indices = nullptr;
         if (m_sort) {
             sample.m_sort_data.resize(point_count);
             for (int i = 0; i < point_count; ++i) {
@@ -186,40 +196,53 @@ void aiPoints::cookSampleBody(Sample& sample)
                 (sample.m_sort_data.begin(), sample.m_sort_data.end(),
                     [](const std::pair<float, int>& a, const std::pair<float, int>& b) { return a.first > b.first; });
 
-            Remap(sample.m_points, sample.m_points_sp, sample.m_sort_data);
-            if (summary.interpolate_points)
-                Remap(sample.m_points2, sample.m_points_sp2, sample.m_sort_data);
-
-            if (!summary.compute_velocities && sample.m_velocities_sp)
-                Remap(sample.m_velocities, sample.m_velocities_sp, sample.m_sort_data);
+            sample.m_sort_indices.resize_discard(point_count);
+            for (int i = 0; i < point_count; ++i)
+                sample.m_sort_indices[i] = sample.m_sort_data[i].second;
+            indices = sample.m_sort_indices.data();
+        }
 
-            if (sample.m_ids_sp)
-                Remap(sample.m_ids, sample.m_ids_sp, sample.m_sort_data);
+        // gather, swap handedness and scale in one pass
+        bool swap_handedness = config.swap_handedness;
+        float scale = config.scale_factor;
+        sample.m_points.resize_discard(point_count);
+        if (has2 && (int)sample.m_points_sp2->size() == point_count) {
+            // the interpolation at the current time is done along with it
+            if (summary.compute_velocities)
+                sample.m_points_int.swap(sample.m_points_prev);
+            sample.m_points2.resize_discard(point_count);
+            sample.m_points_int.resize_discard(point_count);
+            RemapTransformLerp(sample.m_points.data(), sample.m_points2.data(), sample.m_points_int.data(),
+                sample.m_points_sp->get(), sample.m_points_sp2->get(), indices, point_count,
+                swap_handedness, scale, m_current_time_offset);
+            points_lerped = true;
         }
         else {
-            Assign(sample.m_points, sample.m_points_sp, point_count);
-            if (summary.interpolate_points)
-                Assign(sample.m_points2, sample.m_points_sp2, point_count);
+            RemapTransform(sample.m_points.data(), sample.m_points_sp->get(), indices, point_count, swap_handedness, scale);
+        }
 
-            if (!summary.compute_velocities && sample.m_velocities_sp)
-                Assign(sample.m_velocities, sample.m_velocities_sp, point_count);
+        if (!summary.compute_velocities && sample.m_velocities_sp) {
+            if ((int)sample.m_velocities_sp->size() >= point_count) {
+                sample.m_velocities.resize_discard(point_count);
+                RemapTransform(sample.m_velocities.data(), sample.m_velocities_sp->get(), indices, point_count, swap_handedness, scale);
+            }
+            else {
+                if (m_sort)
+                    Remap(sample.m_velocities, sample.m_velocities_sp, sample.m_sort_data);
+                else
+                    Assign(sample.m_velocities, sample.m_velocities_sp, point_count);
+                RemapTransform(sample.m_velocities.data(), sample.m_velocities.data(), nullptr, point_count, swap_handedness, scale);
+            }
+        }
 
-            if (sample.m_ids_sp)
+        if (sample.m_ids_sp) {
+            if (m_sort)
+                Remap(sample.m_ids, sample.m_ids_sp, sample.m_sort_data);
+            else
                 Assign(sample.m_ids, sample.m_ids_sp, point_count);
         }
         sample.m_points_ref = sample.m_points;
 
-        auto& config = getConfig();
-        if (config.swap_handedness) {
-            SwapHandedness(sample.m_points.data(), (int)sample.m_points.size());
-            SwapHandedness(sample.m_points2.data(), (int)sample.m_points2.size());
-            SwapHandedness(sample.m_velocities.data(), (int)sample.m_velocities.size());
-        }
-        if (config.scale_factor != 1.0f) {
-            ApplyScale(sample.m_points.data(), (int)sample.m_points.size(), config.scale_factor);
-            ApplyScale(sample.m_points2.data(), (int)sample.m_points2.size(), config.scale_factor);
-            ApplyScale(sample.m_velocities.data(), (int)sample.m_velocities.size(), config.scale_factor);
-        }
         {
             abcV3 bbmin, bbmax;
             MinMax(bbmin, bbmax, sample.m_points.data(), (int)sample.m_points.size());
@@ -228,13 +251,25 @@ void aiPoints::cookSampleBody(Sample& sample)
         }
     }
 
+    // the second sample read after the first one, or not gathered along with it
+    if (has2 && !points_lerped && (m_sample_index_changed || read2)) {
+        int count = (int)sample.m_points.size();
+        if (m_sort)
+            Remap(sample.m_points2, sample.m_points_sp2, sample.m_sort_data);
+        else
+            Assign(sample.m_points2, sample.m_points_sp2, count);
+        RemapTransform(sample.m_points2.data(), sample.m_points2.data(), nullptr, count, config.swap_handedness, config.scale_factor);
+    }
+
     if (summary.interpolate_points) {
-        if (summary.compute_velocities)
-            sample.m_points_int.swap(sample.m_points_prev);
+        if (!points_lerped) {
+            if (summary.compute_velocities)
+                sample.m_points_int.swap(sample.m_points_prev);
 
-        sample.m_points_int.resize_discard(sample.m_points.size());
-        Lerp(sample.m_points_int.data(), sample.m_points.data(), sample.m_points2.data(),
-            (int)sample.m_points.size(), m_current_time_offset);
+            sample.m_points_int.resize_discard(sample.m_points.size());
+            Lerp(sample.m_points_int.data(), sample.m_points.data(), has2 ? sample.m_points2.data() : sample.m_points.data(),
+                (int)sample.m_points.size(), m_current_time_offset);
+        }
         sample.m_points_ref = sample.m_points_int;
 
         if (summary.compute_velocities) {
@@ -250,6 +285,22 @@ void aiPoints::cookSampleBody(Sample& sample)
     }
 }
 
+bool aiPoints::getSelfBounds(const abcSampleSelector& ss, abcBoxd& dst)
+{
+    return readSelfBounds(ss, dst);
+}
+
+bool aiPoints::skipHiddenSamples() const
+{
+    return getConfig().skip_hidden_samples;
+}
+
+void aiPoints::carryOverSample(Sample& dst, Sample& prev)
+{
+    // previous interpolated points are needed to compute velocities
+    dst.m_points_int.swap(prev.m_points_int);
+}
+
 void aiPoints::setSort(bool v) { m_sort = v; }
 bool aiPoints::getSort() const { return m_sort; }
 void aiPoints::setSortPosition(const abcV3& v) { m_sort_position = v; }
@@ -26,12 +26,13 @@ public:
     IArray<abcV3> m_points_ref;
 
     RawVector<std::pair<float, int>> m_sort_data;
+    RawVector<int> m_sort_indices;
     RawVector<abcV3> m_points, m_points2, m_points_int, m_points_prev;
     RawVector<abcV3> m_velocities;
     RawVector<uint32_t> m_ids;
     abcV3 m_bb_center, m_bb_size;
 
-    std::future<void> m_async_copy;
+    aiTaskGroup m_async_copy;
 };
 
 struct aiPointsTraits
@@ -51,14 +52,19 @@ public:
     const aiPointsSummaryInternal& getSummary() const;
 
     Sample* newSample() override;
-    void readSampleBody(Sample& sample, uint64_t idx) override;
+    void readSampleBody(Sample& sample, uint64_t idx, bool force_update) override;
     void cookSampleBody(Sample& sample) override;
+    void carryOverSample(Sample& dst, Sample& prev) override;
 
     void setSort(bool v);
     bool getSort() const;
     void setSortPosition(const abcV3& v);
     const abcV3& getSortPosition() const;
 
+protected:
+    bool getSelfBounds(const abcSampleSelector& ss, abcBoxd& dst) override;
+    bool skipHiddenSamples() const override;
+
 private:
     aiPointsSummaryInternal m_summary;
     bool m_sort = false;
@@ -43,8 +43,64 @@ inline void Remap(RawVector<T>& dst, const AbcArraySample& src, const RawVector<
     }
 }
 
+// remap one sample into its frame of baked storage. returns false if the sample doesn't match the topology
+template<class T, class AbcArraySample>
+inline bool RemapFrame(RawVector<T>& baked, size_t frame, const AbcArraySample& src, const RawVector<int>& indices, int vertex_count)
+{
+    size_t n = indices.empty() ? src.size() : indices.size();
+    if (n != (size_t)vertex_count)
+        return false;
+
+    T *dst = baked.data() + frame * vertex_count;
+    if (indices.empty())
+        std::copy(src.get(), src.get() + n, dst);
+    else
+        CopyWithIndices(dst, src.get(), indices);
+    return true;
+}
+
+// Remap() + SwapHandedness() + ApplyScale() in one pass
+template<class AbcArraySample>
+inline void RemapTransform(RawVector<abcV3>& dst, const AbcArraySample& src, const RawVector<int>& indices, bool swap_handedness, float scale)
+{
+    size_t n = indices.empty() ? src.size() : indices.size();
+    dst.resize_discard(n);
+    RemapTransform(dst.data(), src.get(), indices.empty() ? nullptr : indices.data(), (int)n, swap_handedness, scale);
+}
+
+// RemapTransform() both ends of an interpolated frame and interpolate them in one pass.
+// returns false if the ends don't match. the caller falls back to separate passes then.
+template<class AbcArraySample>
+inline bool RemapTransformLerp(RawVector<abcV3>& dst1, RawVector<abcV3>& dst2, RawVector<abcV3>& dst_int,
+    const AbcArraySample& src1, const AbcArraySample& src2, const RawVector<int>& indices, bool swap_handedness, float scale, float w)
+{
+    if (src1.size() != src2.size())
+        return false;
+
+    size_t n = indices.empty() ? src1.size() : indices.size();
+    dst1.resize_discard(n);
+    dst2.resize_discard(n);
+    dst_int.resize_discard(n);
+    RemapTransformLerp(dst1.data(), dst2.data(), dst_int.data(), src1.get(), src2.get(),
+        indices.empty() ? nullptr : indices.data(), (int)n, swap_handedness, scale, w);
+    return true;
+}
+
+// RemapFrame() + SwapHandedness() + ApplyScale() in one pass
+template<class AbcArraySample>
+inline bool RemapTransformFrame(RawVector<abcV3>& baked, size_t frame, const AbcArraySample& src, const RawVector<int>& indices, int vertex_count,
+    bool swap_handedness, float scale)
+{
+    size_t n = indices.empty() ? src.size() : indices.size();
+    if (n != (size_t)vertex_count)
+        return false;
+
+    RemapTransform(baked.data() + frame * vertex_count, src.get(), indices.empty() ? nullptr : indices.data(), vertex_count, swap_handedness, scale);
+    return true;
+}
+
 template<class T>
-inline void Lerp(RawVector<T>& dst, const RawVector<T>& src1, const RawVector<T>& src2, float w)
+inline void Lerp(RawVector<T>& dst, const IArray<T>& src1, const IArray<T>& src2, float w)
 {
     if (src1.size() != src2.size()) {
         DebugError("something is wrong!!");
@@ -54,6 +110,36 @@ inline void Lerp(RawVector<T>& dst, const RawVector<T>& src1, const RawVector<T>
     Lerp(dst.data(), src1.data(), src2.data(), (int)src1.size(), w);
 }
 
+// true if vbs has a buffer of the attribute for every split and each is large enough (vertex_count is the capacity)
+template<class U>
+inline bool HasDirectBuffers(const std::vector<aiPolyMeshData>& vbs, U* aiPolyMeshData::*member, const RawVector<MeshRefiner::Split>& splits)
+{
+    if (vbs.empty() || vbs.size() != splits.size())
+        return false;
+    for (size_t i = 0; i < splits.size(); ++i) {
+        if (!(vbs[i].*member) || vbs[i].vertex_count < splits[i].vertex_count)
+            return false;
+    }
+    return true;
+}
+
+// Lerp() into the registered buffer of each split
+template<class T, class U>
+inline void LerpToSplits(const std::vector<aiPolyMeshData>& vbs, U* aiPolyMeshData::*member, const RawVector<MeshRefiner::Split>& splits,
+    const IArray<T>& src1, const IArray<T>& src2, float w)
+{
+    for (size_t i = 0; i < splits.size(); ++i) {
+        auto& split = splits[i];
+        Lerp((T*)(vbs[i].*member), src1.data() + split.vertex_offset, src2.data() + split.vertex_offset, split.vertex_count, w);
+    }
+}
+
+template<class T>
+inline void Lerp(RawVector<T>& dst, const RawVector<T>& src1, const RawVector<T>& src2, float w)
+{
+    Lerp(dst, IArray<T>(src1), IArray<T>(src2), w);
+}
+
 
 aiMeshTopology::aiMeshTopology()
 {
@@ -100,6 +186,19 @@ int aiMeshTopology::getSubmeshCount(int split_index) const
     return (int)m_refiner.splits[split_index].submesh_count;
 }
 
+size_t aiPolyMeshCachedSample::getSize() const
+{
+    return sizeof(*this) +
+        m_points.size() * sizeof(abcV3) +
+        m_velocities.size() * sizeof(abcV3) +
+        m_normals.size() * sizeof(abcV3) +
+        m_tangents.size() * sizeof(abcV4) +
+        m_uv0.size() * sizeof(abcV2) +
+        m_uv1.size() * sizeof(abcV2) +
+        m_colors.size() * sizeof(abcC4);
+}
+
+
 aiPolyMeshSample::aiPolyMeshSample(aiPolyMesh *schema, TopologyPtr topo)
     : super(schema)
     , m_topology(topo)
@@ -118,6 +217,7 @@ void aiPolyMeshSample::reset()
     m_normals_sp.reset(); m_normals_sp2.reset();
     m_uv0_sp.reset(); m_uv1_sp.reset();
     m_colors_sp.reset();
+    m_cached.reset(); m_cached2.reset();
 
     m_points_ref.reset();
     m_velocities_ref.reset();
@@ -126,6 +226,8 @@ void aiPolyMeshSample::reset()
     m_normals_ref.reset();
     m_tangents_ref.reset();
     m_colors_ref.reset();
+    m_direct = 0;
+    m_direct_vbs.clear();
 }
 
 void aiPolyMeshSample::getSummary(aiMeshSampleSummary &dst) const
@@ -136,6 +238,7 @@ void aiPolyMeshSample::getSummary(aiMeshSampleSummary &dst) const
     dst.vertex_count  = m_topology->getVertexCount();
     dst.index_count   = m_topology->getIndexCount();
     dst.topology_changed = m_topology_changed;
+    dst.changed = dynamic_cast<schema_t*>(getSchema())->getUnfilled();
 }
 
 void aiPolyMeshSample::getSplitSummaries(aiMeshSplitSummary  *dst) const
@@ -149,7 +252,43 @@ void aiPolyMeshSample::getSplitSummaries(aiMeshSplitSummary  *dst) const
         dst[i].vertex_offset  = src.vertex_offset;
         dst[i].index_count    = src.index_count;
         dst[i].index_offset   = src.index_offset;
+        dst[i].index_size     = getIndexSize(i);
+    }
+}
+
+int aiPolyMeshSample::getIndexSize(int split_index) const
+{
+    auto& schema = *dynamic_cast<schema_t*>(getSchema());
+    auto& split = m_topology->m_refiner.splits[split_index];
+    if (schema.getIndexFormat() == aiIndexFormat::UInt16IfPossible && split.vertex_count <= 0x10000)
+        return 2;
+    return 4;
+}
+
+bool aiPolyMeshSample::getSelfBounds(abcV3& bbmin, abcV3& bbmax) const
+{
+    auto& schema = *dynamic_cast<schema_t*>(getSchema());
+    auto& config = getConfig();
+    if (m_bounds.isEmpty())
+        return false;
+
+    // interpolated points are within the union of the both ends. without the second end the points are the first one
+    auto bounds = m_bounds;
+    if (schema.getSummary().interpolate_points && m_sample_index2 == m_sample_index + 1) {
+        if (m_bounds2.isEmpty())
+            return false;
+        bounds.extendBy(m_bounds2);
+    }
+
+    float scale = config.scale_factor;
+    bbmin = abcV3((float)bounds.min.x, (float)bounds.min.y, (float)bounds.min.z) * scale;
+    bbmax = abcV3((float)bounds.max.x, (float)bounds.max.y, (float)bounds.max.z) * scale;
+    if (config.swap_handedness) {
+        float x = bbmin.x;
+        bbmin.x = -bbmax.x;
+        bbmax.x = -x;
     }
+    return true;
 }
 
 void aiPolyMeshSample::getSubmeshSummaries(aiSubmeshSummary *dst) const
@@ -164,21 +303,59 @@ void aiPolyMeshSample::getSubmeshSummaries(aiSubmeshSummary *dst) const
     }
 }
 
+// registered buffer of the split if the last cook wrote the attribute straight into it and it is still registered
 template<class T>
-static inline void copy_or_clear(T* dst, const IArray<T>& src, const MeshRefiner::Split& split)
+static inline const T* get_direct(const aiPolyMeshSample& sample, uint32_t bit, T* aiPolyMeshData::*member, int split_index)
+{
+    auto& vbs = dynamic_cast<aiPolyMesh*>(sample.getSchema())->getVertexBuffers();
+    if (!(sample.m_direct & bit) || split_index >= (int)sample.m_direct_vbs.size() || split_index >= (int)vbs.size())
+        return nullptr;
+    auto *ret = sample.m_direct_vbs[split_index].*member;
+    return ret == vbs[split_index].*member ? ret : nullptr;
+}
+
+template<class T>
+static inline void copy_or_clear(T* dst, const IArray<T>& src, const MeshRefiner::Split& split, const T* direct)
 {
     if (dst) {
-        if (!src.empty())
-            src.copy_to(dst, split.vertex_count, split.vertex_offset);
+        if (direct) {
+            if (dst != direct)
+                memcpy(dst, direct, split.vertex_count * sizeof(T));
+        }
+        else if (!src.empty()) {
+            if (dst != src.data() + split.vertex_offset)
+                src.copy_to(dst, split.vertex_count, split.vertex_offset);
+        }
         else
             memset(dst, 0, split.vertex_count * sizeof(T));
     }
 }
 
-void aiPolyMeshSample::fillSplitVertices(int split_index, aiPolyMeshData &data) const
+// the split's part of the cooked data. nullptr if there is none
+template<class T>
+static inline const T* split_source(const IArray<T>& src, const MeshRefiner::Split& split, const T* direct)
+{
+    if (direct)
+        return direct;
+    return src.empty() ? nullptr : src.data() + split.vertex_offset;
+}
+
+// dst has components of U per vertex
+template<class T, class U>
+static inline void convert_or_clear(U* dst, const T* src, const MeshRefiner::Split& split, int components,
+    void (*convert)(U*, const T*, int))
+{
+    if (src)
+        convert(dst, src, split.vertex_count);
+    else
+        memset(dst, 0, split.vertex_count * components * sizeof(U));
+}
+
+void aiPolyMeshSample::fillSplitVertices(int split_index, aiPolyMeshData &data, uint32_t attrs) const
 {
     auto& schema = *dynamic_cast<schema_t*>(getSchema());
     auto& summary = schema.getSummary();
+    auto& formats = schema.getVertexFormats();
     auto& splits = m_topology->m_refiner.splits;
     if (split_index < 0 || size_t(split_index) >= splits.size() || splits[split_index].vertex_count == 0)
         return;
@@ -186,23 +363,82 @@ void aiPolyMeshSample::fillSplitVertices(int split_index, aiPolyMeshData &data)
     auto& refiner = m_topology->m_refiner;
     auto& split = refiner.splits[split_index];
 
-    if (data.points) {
-        m_points_ref.copy_to(data.points, split.vertex_count, split.vertex_offset);
-
-        // bounds
-        abcV3 bbmin, bbmax;
-        MinMax(bbmin, bbmax, data.points, split.vertex_count);
+    // attributes written straight into registered buffers by the cook are copied from there, or not at all if
+    // the destination is that buffer. attributes in other formats than Float are converted.
+    if (data.points && (attrs & aiPolyMeshAttr_Points)) {
+        // bounds are the archive's self bounds if they cover the split, otherwise computed while copying points
+        abcV3 bbmin(0.0f, 0.0f, 0.0f), bbmax(0.0f, 0.0f, 0.0f);
+        bool self_bounds = (splits.size() == 1 || getConfig().trust_file_bounds) && getSelfBounds(bbmin, bbmax);
+
+        auto *src = split_source(m_points_ref, split,
+            get_direct(*this, aiPolyMeshAttr_Points, &aiPolyMeshData::points, split_index));
+        if (formats.points == aiVertexFormat::Half) {
+            convert_or_clear((uint16_t*)data.points, src, split, 4, FloatToHalf);
+            if (src && !self_bounds)
+                MinMax(bbmin, bbmax, src, split.vertex_count);
+        }
+        else if (!src) {
+            memset(data.points, 0, split.vertex_count * sizeof(abcV3));
+        }
+        else if (self_bounds) {
+            if (data.points != src)
+                memcpy(data.points, src, split.vertex_count * sizeof(abcV3));
+        }
+        else {
+            if (data.points != src)
+                CopyMinMax(data.points, bbmin, bbmax, src, split.vertex_count);
+            else
+                MinMax(bbmin, bbmax, src, split.vertex_count);
+        }
         data.center = (bbmin + bbmax) * 0.5f;
         data.extents = bbmax - bbmin;
     }
 
     // note: velocity can be empty even if summary.has_velocities is true (compute is enabled & first frame)
-    copy_or_clear(data.velocities, m_velocities_ref, split);
-    copy_or_clear(data.normals, m_normals_ref, split);
-    copy_or_clear(data.tangents, m_tangents_ref, split);
-    copy_or_clear(data.uv0, m_uv0_ref, split);
-    copy_or_clear(data.uv1, m_uv1_ref, split);
-    copy_or_clear((abcC4*)data.colors, m_colors_ref, split);
+    if (data.velocities && (attrs & aiPolyMeshAttr_Velocities)) {
+        auto *direct = get_direct(*this, aiPolyMeshAttr_Velocities, &aiPolyMeshData::velocities, split_index);
+        if (formats.velocities == aiVertexFormat::Half)
+            convert_or_clear((uint16_t*)data.velocities, split_source(m_velocities_ref, split, direct), split, 4, FloatToHalf);
+        else
+            copy_or_clear(data.velocities, m_velocities_ref, split, direct);
+    }
+    if (data.normals && (attrs & aiPolyMeshAttr_Normals)) {
+        auto *direct = get_direct(*this, aiPolyMeshAttr_Normals, &aiPolyMeshData::normals, split_index);
+        if (formats.normals == aiVertexFormat::SNorm16Oct)
+            convert_or_clear((int16_t*)data.normals, split_source(m_normals_ref, split, direct), split, 2, EncodeNormalsOctahedral);
+        else
+            copy_or_clear(data.normals, m_normals_ref, split, direct);
+    }
+    if (data.tangents && (attrs & aiPolyMeshAttr_Tangents)) {
+        auto *direct = get_direct(*this, aiPolyMeshAttr_Tangents, &aiPolyMeshData::tangents, split_index);
+        if (formats.tangents == aiVertexFormat::SNorm16Oct)
+            convert_or_clear((int16_t*)data.tangents, split_source(m_tangents_ref, split, direct), split, 4, EncodeTangentsOctahedral);
+        else
+            copy_or_clear(data.tangents, m_tangents_ref, split, direct);
+    }
+    if (data.uv0 && (attrs & aiPolyMeshAttr_UV0)) {
+        auto *direct = get_direct(*this, aiPolyMeshAttr_UV0, &aiPolyMeshData::uv0, split_index);
+        if (formats.uv0 == aiVertexFormat::Half)
+            convert_or_clear((uint16_t*)data.uv0, split_source(m_uv0_ref, split, direct), split, 2, FloatToHalf);
+        else
+            copy_or_clear(data.uv0, m_uv0_ref, split, direct);
+    }
+    if (data.uv1 && (attrs & aiPolyMeshAttr_UV1)) {
+        auto *direct = get_direct(*this, aiPolyMeshAttr_UV1, &aiPolyMeshData::uv1, split_index);
+        if (formats.uv1 == aiVertexFormat::Half)
+            convert_or_clear((uint16_t*)data.uv1, split_source(m_uv1_ref, split, direct), split, 2, FloatToHalf);
+        else
+            copy_or_clear(data.uv1, m_uv1_ref, split, direct);
+    }
+    if (data.colors && (attrs & aiPolyMeshAttr_Colors)) {
+        auto *direct = (const abcC4*)get_direct(*this, aiPolyMeshAttr_Colors, &aiPolyMeshData::colors, split_index);
+        if (formats.colors == aiVertexFormat::Half)
+            convert_or_clear((uint16_t*)data.colors, split_source(m_colors_ref, split, direct), split, 4, FloatToHalf);
+        else if (formats.colors == aiVertexFormat::UNorm8)
+            convert_or_clear((uint8_t*)data.colors, split_source(m_colors_ref, split, direct), split, 4, FloatToUNorm8);
+        else
+            copy_or_clear((abcC4*)data.colors, m_colors_ref, split, direct);
+    }
 }
 
 void aiPolyMeshSample::fillSubmeshIndices(int submesh_index, aiSubmeshData &data) const
@@ -212,29 +448,78 @@ void aiPolyMeshSample::fillSubmeshIndices(int submesh_index, aiSubmeshData &data
 
     auto& refiner = m_topology->m_refiner;
     auto& submesh = refiner.submeshes[submesh_index];
-    refiner.new_indices_submeshes.copy_to(data.indices, submesh.index_count, submesh.index_offset);
+    if (getIndexSize(submesh.split_index) == 2) {
+        auto *src = refiner.new_indices_submeshes.data() + submesh.index_offset;
+        auto *dst = (uint16_t*)data.indices;
+        for (int i = 0; i < submesh.index_count; ++i)
+            dst[i] = (uint16_t)src[i];
+    }
+    else {
+        refiner.new_indices_submeshes.copy_to(data.indices, submesh.index_count, submesh.index_offset);
+    }
 }
 
-void aiPolyMeshSample::fillVertexBuffer(aiPolyMeshData * vbs, aiSubmeshData * ibs)
+uint32_t aiPolyMeshSample::fillVertexBuffer(aiPolyMeshData * vbs, aiSubmeshData * ibs)
 {
-    auto body = [this, vbs, ibs]() {
+    uint32_t attrs = dynamic_cast<schema_t*>(getSchema())->takeUnfilled();
+    auto body = [this, vbs, ibs, attrs]() {
         auto& refiner = m_topology->m_refiner;
         for (int spi = 0; spi < (int)refiner.splits.size(); ++spi)
-            fillSplitVertices(spi, vbs[spi]);
-        for (int smi = 0; smi < (int)refiner.submeshes.size(); ++smi)
-            fillSubmeshIndices(smi, ibs[smi]);
+            fillSplitVertices(spi, vbs[spi], attrs);
+        if (attrs & aiPolyMeshAttr_Indices) {
+            for (int smi = 0; smi < (int)refiner.submeshes.size(); ++smi)
+                fillSubmeshIndices(smi, ibs[smi]);
+        }
     };
 
     if (m_force_sync || !getConfig().async_load)
         body();
     else
-        m_async_copy = std::async(std::launch::async, body);
+        m_async_copy.run(body);
+    return attrs;
+}
+
+// direct outputs of each split are gathered into one array as the non-direct path of the cook makes them
+template<class T, class U>
+static inline void gather_direct(RawVector<T>& dst, IArray<T>& ref, const std::vector<aiPolyMeshData>& vbs,
+    U* aiPolyMeshData::*member, const RawVector<MeshRefiner::Split>& splits, int vertex_count)
+{
+    dst.resize_discard(vertex_count);
+    for (size_t spi = 0; spi < splits.size(); ++spi) {
+        auto& split = splits[spi];
+        memcpy(dst.data() + split.vertex_offset, vbs[spi].*member, split.vertex_count * sizeof(T));
+    }
+    ref = dst;
+}
+
+void aiPolyMeshSample::detachDirectBuffers()
+{
+    if (m_direct) {
+        auto& splits = m_topology->m_refiner.splits;
+        int vertex_count = m_topology->m_vertex_count;
+        auto& vbs = m_direct_vbs;
+        if (m_direct & aiPolyMeshAttr_Points)
+            gather_direct(m_points_int, m_points_ref, vbs, &aiPolyMeshData::points, splits, vertex_count);
+        if (m_direct & aiPolyMeshAttr_Velocities)
+            gather_direct(m_velocities, m_velocities_ref, vbs, &aiPolyMeshData::velocities, splits, vertex_count);
+        if (m_direct & aiPolyMeshAttr_Normals)
+            gather_direct(m_normals_int, m_normals_ref, vbs, &aiPolyMeshData::normals, splits, vertex_count);
+        if (m_direct & aiPolyMeshAttr_Tangents)
+            gather_direct(m_tangents, m_tangents_ref, vbs, &aiPolyMeshData::tangents, splits, vertex_count);
+        if (m_direct & aiPolyMeshAttr_UV0)
+            gather_direct(m_uv0_int, m_uv0_ref, vbs, &aiPolyMeshData::uv0, splits, vertex_count);
+        if (m_direct & aiPolyMeshAttr_UV1)
+            gather_direct(m_uv1_int, m_uv1_ref, vbs, &aiPolyMeshData::uv1, splits, vertex_count);
+        if (m_direct & aiPolyMeshAttr_Colors)
+            gather_direct(m_colors_int, m_colors_ref, vbs, &aiPolyMeshData::colors, splits, vertex_count);
+    }
+    m_direct = 0;
+    m_direct_vbs.clear();
 }
 
 void aiPolyMeshSample::waitAsync()
 {
-    if (m_async_copy.valid())
-        m_async_copy.wait();
+    m_async_copy.wait();
     m_force_sync = false;
 }
 
@@ -274,12 +559,16 @@ aiPolyMesh::aiPolyMesh(aiObject *parent, const abcObject &abc)
         }
     }
 
+    m_shared = std::make_shared<aiPolyMeshSharedData>();
     updateSummary();
 }
 
 aiPolyMesh::~aiPolyMesh()
 {
     waitAsync();
+    waitPrefetch();
+    getContext()->getSampleCache().erase(this);
+    releaseSharedData();
 }
 
 void aiPolyMesh::updateSummary()
@@ -431,30 +720,185 @@ const aiMeshSummaryInternal& aiPolyMesh::getSummary() const
     return m_summary;
 }
 
+void aiPolyMesh::waitCookAndFill()
+{
+    waitAsync();
+    if (m_sample)
+        m_sample->waitAsync();
+}
+
+void aiPolyMesh::setVertexBuffers(const aiPolyMeshData *vbs, int split_count)
+{
+    waitCookAndFill();
+
+    // outputs of the current sample may be only in the old buffers. they must not be referred to after this
+    if (m_sample)
+        m_sample->detachDirectBuffers();
+    if (vbs && split_count > 0)
+        m_vertex_buffers.assign(vbs, vbs + split_count);
+    else
+        m_vertex_buffers.clear();
+}
+
+const std::vector<aiPolyMeshData>& aiPolyMesh::getVertexBuffers() const
+{
+    return m_vertex_buffers;
+}
+
+void aiPolyMesh::setVertexFormats(const aiPolyMeshVertexFormats& formats)
+{
+    waitCookAndFill();
+    m_vertex_formats = formats;
+    m_unfilled = aiPolyMeshAttr_All;
+}
+
+const aiPolyMeshVertexFormats& aiPolyMesh::getVertexFormats() const
+{
+    return m_vertex_formats;
+}
+
+void aiPolyMesh::setIndexFormat(aiIndexFormat format)
+{
+    waitCookAndFill();
+    m_index_format = format;
+    m_unfilled = aiPolyMeshAttr_All;
+}
+
+aiIndexFormat aiPolyMesh::getIndexFormat() const
+{
+    return m_index_format;
+}
+
+void aiPolyMesh::setSkipUnchanged(bool v)
+{
+    waitCookAndFill();
+    m_skip_unchanged = v;
+    m_unfilled = aiPolyMeshAttr_All;
+}
+
+uint32_t aiPolyMesh::getUnfilled() const
+{
+    return m_unfilled;
+}
+
+uint32_t aiPolyMesh::takeUnfilled()
+{
+    uint32_t unfilled = m_unfilled.exchange(0);
+    return m_skip_unchanged ? unfilled : (uint32_t)aiPolyMeshAttr_All;
+}
+
 aiPolyMesh::Sample* aiPolyMesh::newSample()
 {
     if (!m_varying_topology) {
-        if (!m_shared_topology)
-            m_shared_topology.reset(new aiMeshTopology());
-        return new Sample(this, m_shared_topology);
+        return new Sample(this, m_shared->topology);
     }
     else {
         return new Sample(this, TopologyPtr(new aiMeshTopology()));
     }
 }
 
-void aiPolyMesh::readSampleBody(Sample& sample, uint64_t idx)
+template<class T>
+IArray<T> aiPolyMesh::getBakedFrame(const RawVector<T>& src, int64_t idx) const
+{
+    // next sample of the last one is itself (same as Alembic's index clamping)
+    idx = std::min(idx, m_num_samples - 1);
+    return { src.data() + (size_t)(idx - m_baked_begin) * m_baked_vertex_count, (size_t)m_baked_vertex_count };
+}
+
+void aiPolyMesh::updateSampleBody(const abcSampleSelector& ss)
+{
+    if (!m_varying_topology) {
+        if (m_force_update && m_shared_published) {
+            // topology will be rebuilt. leave the shared one untouched and start with own data
+            releaseSharedData();
+            m_shared = std::make_shared<aiPolyMeshSharedData>();
+            m_shared_adopted = false;
+        }
+        else if (!m_shared_published && m_shared->topology->m_vertex_count == 0) {
+            acquireSharedData();
+        }
+    }
+    else if (m_force_update) {
+        clearTopologyCache();
+    }
+    super::updateSampleBody(ss);
+}
+
+bool aiPolyMesh::getSelfBounds(const abcSampleSelector& ss, abcBoxd& dst)
+{
+    return readSelfBounds(ss, dst);
+}
+
+bool aiPolyMesh::skipHiddenSamples() const
+{
+    return getConfig().skip_hidden_samples;
+}
+
+// moves the second sample of the last index to the first one
+static bool TakeSample(Abc::P3fArraySamplePtr& dst, Abc::P3fArraySamplePtr& src)
+{
+    if (!src)
+        return false;
+    dst.swap(src);
+    src.reset();
+    return true;
+}
+
+template<class GeomParamSample>
+static bool TakeSample(GeomParamSample& dst, GeomParamSample& src)
+{
+    if (!src.valid())
+        return false;
+    dst = src;
+    src.reset();
+    return true;
+}
+
+template<class Property>
+static bool GetArrayKey(aiArrayKey& dst, Property prop, const abcSampleSelector& ss)
+{
+    // keys are stored in the archive. this doesn't read the array itself
+    AbcCoreAbstract::ArraySampleKey key;
+    dst = aiArrayKey();
+    if (!prop.valid() || !prop.getKey(key, ss))
+        return false;
+    dst.size = key.numBytes;
+    dst.digest[0] = key.digest.words[0];
+    dst.digest[1] = key.digest.words[1];
+    dst.valid = true;
+    return true;
+}
+
+void aiPolyMesh::readSampleBody(Sample& sample, uint64_t idx, bool force_update)
 {
     auto ss = aiIndexToSampleSelector(idx);
-    auto ss2 = aiIndexToSampleSelector(idx + 1);
 
     readVisibility(sample, ss);
-    
+
+    // m_shared may have been replaced since the sample was made
+    if (!m_varying_topology)
+        sample.m_topology = m_shared->topology;
+
+    // heterogeneous topology often repeats for long runs. reuse the refined one if the source arrays are identical
+    bool topology_reused = false;
+    sample.m_topology_key.clear();
+    if (m_varying_topology) {
+        if (!force_update && getTopologyKey(sample.m_topology_key, ss)) {
+            if (auto topology = findTopology(sample.m_topology_key)) {
+                sample.m_topology = topology;
+                topology_reused = true;
+            }
+        }
+        // cached topologies are read only
+        if (!topology_reused && sample.m_topology.use_count() > 1)
+            sample.m_topology.reset(new aiMeshTopology());
+    }
+
     auto& topology = *sample.m_topology;
     auto& refiner = topology.m_refiner;
     auto& summary = m_summary;
 
-    bool topology_changed = m_varying_topology || m_force_update_local;
+    bool topology_changed = (m_varying_topology && !topology_reused) || force_update;
 
     if (topology_changed)
         topology.clear();
@@ -477,59 +921,148 @@ void aiPolyMesh::readSampleBody(Sample& sample, uint64_t idx)
         }
     }
 
+    // baked or revisited samples don't need their arrays
+    bool take2 = !topology_changed && canTakeSecondSample(sample, idx);
+    sample.m_sample_index = (int64_t)idx;
+    sample.m_sample_index2 = -1;
+    sample.m_baked = !topology_changed && isBaked(topology, idx);
+    sample.m_cached.reset();
+    sample.m_cached2.reset();
+    if (!topology_changed && !sample.m_baked)
+        sample.m_cached = findCachedSample(topology, idx);
+    bool read1 = !sample.m_baked && !sample.m_cached;
+
+    // keys let the cook skip attributes identical to the last cooked ones
+    sample.m_keys = aiPolyMeshKeys();
+
     // points
-    if (summary.has_points && m_constant_points.empty()) {
+    if (summary.has_points && m_shared->constant_points.empty()) {
         auto param = m_schema.getPositionsProperty();
-        param.get(sample.m_points_sp, ss);
-        if (summary.interpolate_points) {
-            param.get(sample.m_points_sp2, ss2);
-        }
-        else {
-            if (summary.has_velocities_prop) {
-                m_schema.getVelocitiesProperty().get(sample.m_velocities_sp, ss);
+        GetArrayKey(sample.m_keys.points, param, ss);
+        if (read1 && !(take2 && TakeSample(sample.m_points_sp, sample.m_points_sp2)))
+            param.get(sample.m_points_sp, ss);
+        if (!summary.interpolate_points) {
+            if (summary.has_velocities_prop && read1) {
+                auto velocities = m_schema.getVelocitiesProperty();
+                GetArrayKey(sample.m_keys.velocities, velocities, ss);
+                velocities.get(sample.m_velocities_sp, ss);
             }
         }
     }
 
     // normals
-    if (m_constant_normals.empty() && summary.has_normals_prop && !summary.compute_normals) {
+    if (m_shared->constant_normals.empty() && summary.has_normals_prop && !summary.compute_normals) {
         auto param = m_schema.getNormalsParam();
-        param.getIndexed(sample.m_normals_sp, ss);
-        if (summary.interpolate_normals) {
-            param.getIndexed(sample.m_normals_sp2, ss2);
-        }
+        GetArrayKey(sample.m_keys.normals, param.getValueProperty(), ss);
+        if (read1 && !(take2 && TakeSample(sample.m_normals_sp, sample.m_normals_sp2)))
+            param.getIndexed(sample.m_normals_sp, ss);
     }
 
     // uv0
-    if (m_constant_uv0.empty() && summary.has_uv0_prop) {
+    if (m_shared->constant_uv0.empty() && summary.has_uv0_prop) {
         auto param = m_schema.getUVsParam();
-        param.getIndexed(sample.m_uv0_sp, ss);
-        if (summary.interpolate_uv0) {
-            param.getIndexed(sample.m_uv0_sp2, ss2);
-        }
+        GetArrayKey(sample.m_keys.uv0, param.getValueProperty(), ss);
+        if (read1 && !(take2 && TakeSample(sample.m_uv0_sp, sample.m_uv0_sp2)))
+            param.getIndexed(sample.m_uv0_sp, ss);
     }
 
     // uv1
-    if (m_constant_uv1.empty() && summary.has_uv1_prop) {
-        m_uv1_param.getIndexed(sample.m_uv1_sp, ss);
-        if (summary.interpolate_uv1) {
-            m_uv1_param.getIndexed(sample.m_uv1_sp2, ss2);
-        }
+    if (m_shared->constant_uv1.empty() && summary.has_uv1_prop) {
+        GetArrayKey(sample.m_keys.uv1, m_uv1_param.getValueProperty(), ss);
+        if (read1 && !(take2 && TakeSample(sample.m_uv1_sp, sample.m_uv1_sp2)))
+            m_uv1_param.getIndexed(sample.m_uv1_sp, ss);
     }
 
     // colors
-    if (m_constant_colors.empty() && summary.has_colors_prop) {
-        m_colors_param.getIndexed(sample.m_colors_sp, ss);
-        if (summary.interpolate_colors) {
-            m_colors_param.getIndexed(sample.m_colors_sp2, ss2);
+    if (m_shared->constant_colors.empty() && summary.has_colors_prop) {
+        GetArrayKey(sample.m_keys.colors, m_colors_param.getValueProperty(), ss);
+        if (read1 && !(take2 && TakeSample(sample.m_colors_sp, sample.m_colors_sp2)))
+            m_colors_param.getIndexed(sample.m_colors_sp, ss);
+    }
+
+    if (take2 && !sample.m_bounds2.isEmpty()) {
+        sample.m_bounds = sample.m_bounds2;
+    }
+    else {
+        sample.m_bounds.makeEmpty();
+        auto bounds_param = m_schema.getSelfBoundsProperty();
+        if (bounds_param && bounds_param.getNumSamples() > 0)
+            bounds_param.get(sample.m_bounds, ss);
+    }
+
+    // the second sample is read by the cook if needed
+    sample.m_points_sp2.reset();
+    sample.m_normals_sp2.reset();
+    sample.m_uv0_sp2.reset();
+    sample.m_uv1_sp2.reset();
+    sample.m_colors_sp2.reset();
+    sample.m_bounds2.makeEmpty();
+
+    sample.m_topology_changed = topology_changed || topology_reused;
+    sample.m_topology_reused = topology_reused;
+}
+
+void aiPolyMesh::commitSample(Sample& sample)
+{
+    // the read only looked the topology up. mark it recently used
+    if (m_varying_topology && sample.m_topology_reused && !sample.m_topology_key.empty())
+        touchTopology(sample.m_topology_key, sample.m_topology);
+
+    // the first sample after adopting shared data reports the topology so that the client uploads constant data
+    if (m_shared_adopted) {
+        m_shared_adopted = false;
+        if (!sample.m_topology_changed) {
+            sample.m_topology_changed = true;
+            sample.m_topology_reused = true;
         }
     }
+}
+
+bool aiPolyMesh::canTakePrefetchedSample(const Sample& sample) const
+{
+    // m_shared may have been replaced since the read. such samples were read against the old topology
+    return m_varying_topology || (sample.m_topology == m_shared->topology && !sample.m_topology_changed);
+}
+
+void aiPolyMesh::readSecondSample(Sample& sample)
+{
+    int64_t idx = sample.m_sample_index + 1;
+    auto ss2 = aiIndexToSampleSelector(idx);
+    auto& topology = *sample.m_topology;
+    auto& summary = m_summary;
+
+    sample.m_cached2.reset();
+    if (!sample.m_topology_changed && !sample.m_baked)
+        sample.m_cached2 = findCachedSample(topology, idx);
+    bool read2 = !sample.m_baked && !sample.m_cached2;
+
+    sample.m_points_sp2.reset();
+    if (summary.interpolate_points && m_shared->constant_points.empty() && read2)
+        m_schema.getPositionsProperty().get(sample.m_points_sp2, ss2);
 
+    sample.m_normals_sp2.reset();
+    if (summary.interpolate_normals && m_shared->constant_normals.empty() && read2)
+        m_schema.getNormalsParam().getIndexed(sample.m_normals_sp2, ss2);
+
+    sample.m_uv0_sp2.reset();
+    if (summary.interpolate_uv0 && m_shared->constant_uv0.empty() && read2)
+        m_schema.getUVsParam().getIndexed(sample.m_uv0_sp2, ss2);
+
+    sample.m_uv1_sp2.reset();
+    if (summary.interpolate_uv1 && m_shared->constant_uv1.empty() && read2)
+        m_uv1_param.getIndexed(sample.m_uv1_sp2, ss2);
+
+    sample.m_colors_sp2.reset();
+    if (summary.interpolate_colors && m_shared->constant_colors.empty() && read2)
+        m_colors_param.getIndexed(sample.m_colors_sp2, ss2);
+
+    // baked samples need only the bounds
+    sample.m_bounds2.makeEmpty();
     auto bounds_param = m_schema.getSelfBoundsProperty();
-    if (bounds_param && bounds_param.getNumSamples() > 0)
-        bounds_param.get(sample.m_bounds, ss);
+    if (summary.interpolate_points && bounds_param && bounds_param.getNumSamples() > 0)
+        bounds_param.get(sample.m_bounds2, ss2);
 
-    sample.m_topology_changed = topology_changed;
+    sample.m_sample_index2 = idx;
 }
 
 void aiPolyMesh::cookSampleBody(Sample& sample)
@@ -543,60 +1076,199 @@ void aiPolyMesh::cookSampleBody(Sample& sample)
     if (m_varying_topology && !m_sample_index_changed)
         return;
 
-    if (sample.m_topology_changed) {
+    if (sample.m_topology_reused && sample.m_topology == m_last_topology)
+        sample.m_topology_changed = false;
+    if (m_varying_topology)
+        m_last_topology = sample.m_topology;
+
+    // the second ends are read only when the time is between samples. without them the first ends are interpolated
+    // with themselves. they are remapped when they are read, which may be later than the sample index changes.
+    bool interpolate = summary.interpolate_points || summary.interpolate_normals || summary.interpolate_uv0 ||
+        summary.interpolate_uv1 || summary.interpolate_colors;
+    bool read2 = interpolate && needsSecondSample(sample);
+    if (read2)
+        readSecondSample(sample);
+    bool has2 = hasSecondSample(sample);
+
+    // set by readSampleBody() only if the topology is unchanged
+    int64_t idx = sample.m_sample_index;
+    bool baked = sample.m_baked;
+    auto *cached = sample.m_cached.get();
+    auto *cached2 = sample.m_cached2.get();
+
+    // generated normals / tangents can be taken from the cache only if they don't depend on interpolation
+    bool normals_cacheable = !summary.interpolate_points;
+    bool tangents_cacheable = !summary.interpolate_points && !summary.interpolate_normals && !summary.interpolate_uv0;
+
+    // attributes whose source arrays are identical to the last cooked ones keep their buffers.
+    // buffers of the previous sample are moved over by carryOverSample() if read-ahead replaced it.
+    auto& keys = sample.m_keys;
+    bool reuse = !sample.m_topology_changed && m_sample_index_changed && !baked;
+    bool points_unchanged = reuse && keys.points == m_cooked_keys.points;
+    bool velocities_unchanged = reuse && keys.velocities == m_cooked_keys.velocities;
+    bool normals_unchanged = reuse && keys.normals == m_cooked_keys.normals;
+    bool uv0_unchanged = reuse && keys.uv0 == m_cooked_keys.uv0;
+    bool uv1_unchanged = reuse && keys.uv1 == m_cooked_keys.uv1;
+    bool colors_unchanged = reuse && keys.colors == m_cooked_keys.colors;
+    bool gen_normals_unchanged = points_unchanged && normals_cacheable && m_cooked_normals_generated;
+    bool gen_tangents_unchanged = points_unchanged && uv0_unchanged && tangents_cacheable && m_cooked_tangents_generated &&
+        (summary.compute_normals ? gen_normals_unchanged : normals_unchanged);
+    // set if m_points2 and m_points_int were written along with m_points
+    bool points_lerped = false;
+
+    // per frame outputs go straight into the registered vertex buffers if nothing later in the cook reads them as a
+    // whole, or if there is only one split so that its buffer is the whole array
+    bool direct_points = false, direct_velocities = false, direct_normals = false, direct_tangents = false;
+    bool direct_uv0 = false, direct_uv1 = false, direct_colors = false;
+    auto decide_direct = [&]() {
+        auto& vbs = m_vertex_buffers;
+        auto& splits = refiner.splits;
+        auto& formats = m_vertex_formats;
+        bool single = splits.size() == 1;
+        direct_points = formats.points == aiVertexFormat::Float && summary.interpolate_points && !summary.compute_velocities &&
+            (single || (!summary.compute_normals && !summary.compute_tangents)) &&
+            HasDirectBuffers(vbs, &aiPolyMeshData::points, splits);
+        direct_velocities = formats.velocities == aiVertexFormat::Float && summary.interpolate_points && summary.compute_velocities &&
+            HasDirectBuffers(vbs, &aiPolyMeshData::velocities, splits);
+        // generated normals / tangents only if they are regenerated every frame
+        direct_normals = formats.normals == aiVertexFormat::Float && m_shared->constant_normals.empty() &&
+            (summary.interpolate_normals ? (single || !summary.compute_tangents) :
+                (single && summary.compute_normals && summary.interpolate_points)) &&
+            HasDirectBuffers(vbs, &aiPolyMeshData::normals, splits);
+        direct_tangents = formats.tangents == aiVertexFormat::Float && single && summary.compute_tangents && m_shared->constant_tangents.empty() &&
+            (summary.interpolate_points || summary.interpolate_normals) &&
+            HasDirectBuffers(vbs, &aiPolyMeshData::tangents, splits);
+        direct_uv0 = formats.uv0 == aiVertexFormat::Float && summary.interpolate_uv0 && (single || !summary.compute_tangents) &&
+            HasDirectBuffers(vbs, &aiPolyMeshData::uv0, splits);
+        direct_uv1 = formats.uv1 == aiVertexFormat::Float && summary.interpolate_uv1 && HasDirectBuffers(vbs, &aiPolyMeshData::uv1, splits);
+        direct_colors = formats.colors == aiVertexFormat::Float && summary.interpolate_colors && HasDirectBuffers(vbs, &aiPolyMeshData::colors, splits);
+    };
+    decide_direct();
+    sample.m_direct = 0;
+
+    if (sample.m_topology_changed && !sample.m_topology_reused) {
+        // remap tables will be rebuilt. cached and baked data of this schema are no longer valid
+        getContext()->getSampleCache().erase(this);
+        releaseBake();
+        m_cooked_keys = aiPolyMeshKeys();
         onTopologyChange(sample);
+        if (!sample.m_topology_key.empty() && topology.m_vertex_count > 0)
+            storeTopology(sample.m_topology_key, sample.m_topology);
+        decide_direct();
     }
     else if(m_sample_index_changed) {
         onTopologyDetermined();
 
         // make remapped vertex buffer
-        if (!m_constant_points.empty()) {
-            sample.m_points_ref = m_constant_points;
+        if (!m_shared->constant_points.empty()) {
+            sample.m_points_ref = m_shared->constant_points;
+        }
+        else if (baked) {
+            sample.m_points_ref = getBakedFrame(m_baked_points, idx);
         }
         else {
-            Remap(sample.m_points, *sample.m_points_sp, topology.m_remap_points);
-            if (config.swap_handedness)
-                SwapHandedness(sample.m_points.data(), (int)sample.m_points.size());
-            if (config.scale_factor != 1.0f)
-                ApplyScale(sample.m_points.data(), (int)sample.m_points.size(), config.scale_factor);
+            if (points_unchanged) {
+                // keep
+            }
+            else if (cached) {
+                sample.m_points = cached->m_points;
+            }
+            else if (summary.interpolate_points && has2 && !cached2 && !direct_points) {
+                // both ends and the interpolated points in one pass
+                if (summary.compute_velocities)
+                    sample.m_points_int.swap(sample.m_points_prev);
+                points_lerped = RemapTransformLerp(sample.m_points, sample.m_points2, sample.m_points_int,
+                    *sample.m_points_sp, *sample.m_points_sp2, topology.m_remap_points,
+                    config.swap_handedness, config.scale_factor, m_current_time_offset);
+                if (!points_lerped) {
+                    if (summary.compute_velocities)
+                        sample.m_points_int.swap(sample.m_points_prev);
+                    RemapTransform(sample.m_points, *sample.m_points_sp, topology.m_remap_points, config.swap_handedness, config.scale_factor);
+                }
+            }
+            else {
+                RemapTransform(sample.m_points, *sample.m_points_sp, topology.m_remap_points, config.swap_handedness, config.scale_factor);
+            }
             sample.m_points_ref = sample.m_points;
         }
 
-        if (!m_constant_normals.empty()) {
-            sample.m_normals_ref = m_constant_normals;
+        if (!m_shared->constant_normals.empty()) {
+            sample.m_normals_ref = m_shared->constant_normals;
+        }
+        else if (!summary.compute_normals && summary.has_normals_prop && baked) {
+            sample.m_normals_ref = getBakedFrame(m_baked_normals, idx);
         }
         else if (!summary.compute_normals && summary.has_normals_prop) {
-            Remap(sample.m_normals, *sample.m_normals_sp.getVals(), topology.m_remap_normals);
-            if (config.swap_handedness)
-                SwapHandedness(sample.m_normals.data(), (int)sample.m_normals.size());
+            if (normals_unchanged) {
+                // keep
+            }
+            else if (cached) {
+                sample.m_normals = cached->m_normals;
+            }
+            else {
+                RemapTransform(sample.m_normals, *sample.m_normals_sp.getVals(), topology.m_remap_normals, config.swap_handedness, 1.0f);
+            }
             sample.m_normals_ref = sample.m_normals;
         }
 
-        if (!m_constant_tangents.empty()) {
-            sample.m_tangents_ref = m_constant_tangents;
+        if (!m_shared->constant_tangents.empty()) {
+            sample.m_tangents_ref = m_shared->constant_tangents;
         }
 
-        if (!m_constant_uv0.empty()) {
-            sample.m_uv0_ref = m_constant_uv0;
+        if (!m_shared->constant_uv0.empty()) {
+            sample.m_uv0_ref = m_shared->constant_uv0;
+        }
+        else if (summary.has_uv0_prop && baked) {
+            sample.m_uv0_ref = getBakedFrame(m_baked_uv0, idx);
         }
         else if (summary.has_uv0_prop) {
-            Remap(sample.m_uv0, *sample.m_uv0_sp.getVals(), topology.m_remap_uv0);
+            if (uv0_unchanged) {
+                // keep
+            }
+            else if (cached) {
+                sample.m_uv0 = cached->m_uv0;
+            }
+            else {
+                Remap(sample.m_uv0, *sample.m_uv0_sp.getVals(), topology.m_remap_uv0);
+            }
             sample.m_uv0_ref = sample.m_uv0;
         }
 
-        if (!m_constant_uv1.empty()) {
-            sample.m_uv1_ref = m_constant_uv1;
+        if (!m_shared->constant_uv1.empty()) {
+            sample.m_uv1_ref = m_shared->constant_uv1;
+        }
+        else if (summary.has_uv1_prop && baked) {
+            sample.m_uv1_ref = getBakedFrame(m_baked_uv1, idx);
         }
         else if (summary.has_uv1_prop) {
-            Remap(sample.m_uv1, *sample.m_uv1_sp.getVals(), topology.m_remap_uv1);
+            if (uv1_unchanged) {
+                // keep
+            }
+            else if (cached) {
+                sample.m_uv1 = cached->m_uv1;
+            }
+            else {
+                Remap(sample.m_uv1, *sample.m_uv1_sp.getVals(), topology.m_remap_uv1);
+            }
             sample.m_uv1_ref = sample.m_uv1;
         }
 
-        if (!m_constant_colors.empty()) {
-            sample.m_colors_ref = m_constant_colors;
+        if (!m_shared->constant_colors.empty()) {
+            sample.m_colors_ref = m_shared->constant_colors;
+        }
+        else if (summary.has_colors_prop && baked) {
+            sample.m_colors_ref = getBakedFrame(m_baked_colors, idx);
         }
         else if (summary.has_colors_prop) {
-            Remap(sample.m_colors, *sample.m_colors_sp.getVals(), topology.m_remap_colors);
+            if (colors_unchanged) {
+                // keep
+            }
+            else if (cached) {
+                sample.m_colors = cached->m_colors;
+            }
+            else {
+                Remap(sample.m_colors, *sample.m_colors_sp.getVals(), topology.m_remap_colors);
+            }
             sample.m_colors_ref = sample.m_colors;
         }
     }
@@ -604,45 +1276,67 @@ void aiPolyMesh::cookSampleBody(Sample& sample)
         onTopologyDetermined();
     }
 
-    if (m_sample_index_changed) {
-        // both in the case of topology changed or sample index changed
-
-        if (summary.interpolate_points) {
-            Remap(sample.m_points2, *sample.m_points_sp2, topology.m_remap_points);
-            if (config.swap_handedness)
-                SwapHandedness(sample.m_points2.data(), (int)sample.m_points2.size());
-            if (config.scale_factor != 1.0f)
-                ApplyScale(sample.m_points2.data(), (int)sample.m_points2.size(), config.scale_factor);
+    if (has2 && (m_sample_index_changed || read2)) {
+        if (summary.interpolate_points && !baked && !points_lerped) {
+            if (cached2) {
+                sample.m_points2 = cached2->m_points;
+            }
+            else {
+                RemapTransform(sample.m_points2, *sample.m_points_sp2, topology.m_remap_points, config.swap_handedness, config.scale_factor);
+            }
         }
 
-        if (summary.interpolate_normals) {
-            Remap(sample.m_normals2, *sample.m_normals_sp2.getVals(), topology.m_remap_normals);
-            if (config.swap_handedness)
-                SwapHandedness(sample.m_normals2.data(), (int)sample.m_normals2.size());
+        if (summary.interpolate_normals && !baked) {
+            if (cached2) {
+                sample.m_normals2 = cached2->m_normals;
+            }
+            else {
+                RemapTransform(sample.m_normals2, *sample.m_normals_sp2.getVals(), topology.m_remap_normals, config.swap_handedness, 1.0f);
+            }
         }
 
-        if (summary.interpolate_uv0) {
-            Remap(sample.m_uv02, *sample.m_uv0_sp2.getVals(), topology.m_remap_uv0);
+        if (summary.interpolate_uv0 && !baked) {
+            if (cached2)
+                sample.m_uv02 = cached2->m_uv0;
+            else
+                Remap(sample.m_uv02, *sample.m_uv0_sp2.getVals(), topology.m_remap_uv0);
         }
 
-        if (summary.interpolate_uv1) {
-            Remap(sample.m_uv12, *sample.m_uv1_sp2.getVals(), topology.m_remap_uv1);
+        if (summary.interpolate_uv1 && !baked) {
+            if (cached2)
+                sample.m_uv12 = cached2->m_uv1;
+            else
+                Remap(sample.m_uv12, *sample.m_uv1_sp2.getVals(), topology.m_remap_uv1);
         }
 
-        if (summary.interpolate_colors) {
-            Remap(sample.m_colors2, *sample.m_colors_sp2.getVals(), topology.m_remap_colors);
+        if (summary.interpolate_colors && !baked) {
+            if (cached2)
+                sample.m_colors2 = cached2->m_colors;
+            else
+                Remap(sample.m_colors2, *sample.m_colors_sp2.getVals(), topology.m_remap_colors);
         }
+    }
 
-        if (!m_constant_velocities.empty()) {
-            sample.m_velocities_ref = m_constant_velocities;
+    if (m_sample_index_changed) {
+        // both in the case of topology changed or sample index changed
+
+        if (!m_shared->constant_velocities.empty()) {
+            sample.m_velocities_ref = m_shared->constant_velocities;
+        }
+        else if (!summary.compute_velocities && summary.has_velocities_prop && baked) {
+            sample.m_velocities_ref = getBakedFrame(m_baked_velocities, idx);
         }
-        else if (!summary.compute_velocities && summary.has_velocities_prop) {
-            auto& dst = summary.constant_velocities ? m_constant_velocities : sample.m_velocities;
-            Remap(dst, *sample.m_velocities_sp, topology.m_remap_points);
-            if (config.swap_handedness)
-                SwapHandedness(dst.data(), (int)dst.size());
-            if (config.scale_factor != 1.0f)
-                ApplyScale(dst.data(), (int)dst.size(), config.scale_factor);
+        else if (!summary.compute_velocities && summary.has_velocities_prop && !summary.constant_velocities) {
+            auto& dst = sample.m_velocities;
+            if (velocities_unchanged) {
+                // keep
+            }
+            else if (cached) {
+                dst = cached->m_velocities;
+            }
+            else {
+                RemapTransform(dst, *sample.m_velocities_sp, topology.m_remap_points, config.swap_handedness, config.scale_factor);
+            }
             sample.m_velocities_ref = dst;
         }
     }
@@ -650,40 +1344,100 @@ void aiPolyMesh::cookSampleBody(Sample& sample)
     // interpolate or compute data
 
     // points
+    auto& vbs = m_vertex_buffers;
+    auto& splits = refiner.splits;
     if (summary.interpolate_points) {
-        if (summary.compute_velocities)
-            sample.m_points_int.swap(sample.m_points_prev);
-
-        Lerp(sample.m_points_int, sample.m_points, sample.m_points2, m_current_time_offset);
-        sample.m_points_ref = sample.m_points_int;
+        IArray<abcV3> p1 = baked ? getBakedFrame(m_baked_points, idx) : IArray<abcV3>(sample.m_points);
+        IArray<abcV3> p2 = baked ? getBakedFrame(m_baked_points, idx + 1) : has2 ? IArray<abcV3>(sample.m_points2) : p1;
+        if (direct_points && p1.size() == p2.size() && (int)p1.size() == topology.m_vertex_count) {
+            LerpToSplits(vbs, &aiPolyMeshData::points, splits, p1, p2, m_current_time_offset);
+            sample.m_points_ref = { vbs[0].points, (size_t)splits[0].vertex_count };
+            sample.m_direct |= aiPolyMeshAttr_Points;
+        }
+        else {
+            if (!points_lerped) {
+                if (summary.compute_velocities)
+                    sample.m_points_int.swap(sample.m_points_prev);
+                Lerp(sample.m_points_int, p1, p2, m_current_time_offset);
+            }
+            sample.m_points_ref = sample.m_points_int;
+        }
 
         if (summary.compute_velocities) {
-            sample.m_velocities.resize_discard(sample.m_points.size());
-            if (sample.m_points_int.size() == sample.m_points_prev.size()) {
-                GenerateVelocities(sample.m_velocities.data(), sample.m_points_int.data(), sample.m_points_prev.data(),
-                    (int)sample.m_points_int.size(), config.vertex_motion_scale);
+            bool valid = sample.m_points_int.size() == sample.m_points_prev.size();
+            if (direct_velocities && (int)sample.m_points_int.size() == topology.m_vertex_count) {
+                for (size_t spi = 0; spi < splits.size(); ++spi) {
+                    auto& split = splits[spi];
+                    if (valid) {
+                        GenerateVelocities(vbs[spi].velocities, sample.m_points_int.data() + split.vertex_offset,
+                            sample.m_points_prev.data() + split.vertex_offset, split.vertex_count, config.vertex_motion_scale);
+                    }
+                    else {
+                        memset(vbs[spi].velocities, 0, split.vertex_count * sizeof(abcV3));
+                    }
+                }
+                sample.m_velocities.clear();
+                sample.m_velocities_ref.reset();
+                sample.m_direct |= aiPolyMeshAttr_Velocities;
             }
             else {
-                sample.m_velocities.zeroclear();
+                sample.m_velocities.resize_discard(sample.m_points_int.size());
+                if (valid) {
+                    GenerateVelocities(sample.m_velocities.data(), sample.m_points_int.data(), sample.m_points_prev.data(),
+                        (int)sample.m_points_int.size(), config.vertex_motion_scale);
+                }
+                else {
+                    sample.m_velocities.zeroclear();
+                }
+                sample.m_velocities_ref = sample.m_velocities;
             }
-            sample.m_velocities_ref = sample.m_velocities;
         }
     }
 
     // normals
-    if (!m_constant_normals.empty()) {
+    if (!m_shared->constant_normals.empty()) {
         // do nothing
     }
     else if(summary.interpolate_normals) {
-        Lerp(sample.m_normals_int, sample.m_normals, sample.m_normals2, (float)m_current_time_offset);
-        Normalize(sample.m_normals_int.data(), (int)sample.m_normals.size());
-        sample.m_normals_ref = sample.m_normals_int;
+        IArray<abcV3> n1 = baked ? getBakedFrame(m_baked_normals, idx) : IArray<abcV3>(sample.m_normals);
+        IArray<abcV3> n2 = baked ? getBakedFrame(m_baked_normals, idx + 1) : has2 ? IArray<abcV3>(sample.m_normals2) : n1;
+        if (direct_normals && n1.size() == n2.size() && (int)n1.size() == topology.m_vertex_count) {
+            LerpToSplits(vbs, &aiPolyMeshData::normals, splits, n1, n2, (float)m_current_time_offset);
+            for (size_t spi = 0; spi < splits.size(); ++spi)
+                Normalize(vbs[spi].normals, splits[spi].vertex_count);
+            sample.m_normals_ref = { vbs[0].normals, (size_t)splits[0].vertex_count };
+            sample.m_direct |= aiPolyMeshAttr_Normals;
+        }
+        else {
+            Lerp(sample.m_normals_int, n1, n2, (float)m_current_time_offset);
+            Normalize(sample.m_normals_int.data(), (int)sample.m_normals_int.size());
+            sample.m_normals_ref = sample.m_normals_int;
+        }
     }
     else if (summary.compute_normals && (m_sample_index_changed || summary.interpolate_points)) {
-        if (sample.m_points_ref.empty()) {
+        if (baked && normals_cacheable) {
+            sample.m_normals_ref = getBakedFrame(m_baked_normals, idx);
+        }
+        else if (gen_normals_unchanged && !sample.m_normals.empty()) {
+            sample.m_normals_ref = sample.m_normals;
+        }
+        else if (cached && normals_cacheable && !cached->m_normals.empty()) {
+            sample.m_normals = cached->m_normals;
+            sample.m_normals_ref = sample.m_normals;
+        }
+        else if (sample.m_points_ref.empty()) {
             DebugError("something is wrong!!");
             sample.m_normals_ref.reset();
         }
+        else if (direct_normals && (int)sample.m_points_ref.size() == splits[0].vertex_count) {
+            // single split. the generated normals are not kept
+            const auto &indices = topology.m_refiner.new_indices_tri;
+            GenerateNormals(vbs[0].normals, sample.m_points_ref.data(), indices.data(),
+                (int)sample.m_points_ref.size(), (int)indices.size() / 3);
+            sample.m_normals.clear();
+            sample.m_normals_ref = { vbs[0].normals, sample.m_points_ref.size() };
+            sample.m_direct |= aiPolyMeshAttr_Normals;
+        }
         else {
             const auto &indices = topology.m_refiner.new_indices_tri;
             sample.m_normals.resize_discard(sample.m_points_ref.size());
@@ -694,14 +1448,32 @@ void aiPolyMesh::cookSampleBody(Sample& sample)
     }
 
     // tangents
-    if (!m_constant_tangents.empty()) {
+    if (!m_shared->constant_tangents.empty()) {
         // do nothing
     }
     else if (summary.compute_tangents && (m_sample_index_changed || summary.interpolate_points || summary.interpolate_normals)) {
-        if (sample.m_points_ref.empty() || sample.m_uv0_ref.empty() || sample.m_normals_ref.empty()) {
+        if (baked && tangents_cacheable) {
+            sample.m_tangents_ref = getBakedFrame(m_baked_tangents, idx);
+        }
+        else if (gen_tangents_unchanged && !sample.m_tangents.empty()) {
+            sample.m_tangents_ref = sample.m_tangents;
+        }
+        else if (cached && tangents_cacheable && !cached->m_tangents.empty()) {
+            sample.m_tangents = cached->m_tangents;
+            sample.m_tangents_ref = sample.m_tangents;
+        }
+        else if (sample.m_points_ref.empty() || sample.m_uv0_ref.empty() || sample.m_normals_ref.empty()) {
             DebugError("something is wrong!!");
             sample.m_tangents_ref.reset();
         }
+        else if (direct_tangents && (int)sample.m_points_ref.size() == splits[0].vertex_count) {
+            const auto &indices = topology.m_refiner.new_indices_tri;
+            GenerateTangents(vbs[0].tangents, sample.m_points_ref.data(), sample.m_uv0_ref.data(), sample.m_normals_ref.data(),
+                indices.data(), (int)sample.m_points_ref.size(), (int)indices.size() / 3);
+            sample.m_tangents.clear();
+            sample.m_tangents_ref = { vbs[0].tangents, sample.m_points_ref.size() };
+            sample.m_direct |= aiPolyMeshAttr_Tangents;
+        }
         else {
             const auto &indices = topology.m_refiner.new_indices_tri;
             sample.m_tangents.resize_discard(sample.m_points_ref.size());
@@ -713,21 +1485,118 @@ void aiPolyMesh::cookSampleBody(Sample& sample)
 
     // uv0
     if (summary.interpolate_uv0) {
-        Lerp(sample.m_uv0_int, sample.m_uv0, sample.m_uv02, m_current_time_offset);
-        sample.m_uv0_ref = sample.m_uv0_int;
+        IArray<abcV2> v1 = baked ? getBakedFrame(m_baked_uv0, idx) : IArray<abcV2>(sample.m_uv0);
+        IArray<abcV2> v2 = baked ? getBakedFrame(m_baked_uv0, idx + 1) : has2 ? IArray<abcV2>(sample.m_uv02) : v1;
+        if (direct_uv0 && v1.size() == v2.size() && (int)v1.size() == topology.m_vertex_count) {
+            LerpToSplits(vbs, &aiPolyMeshData::uv0, splits, v1, v2, m_current_time_offset);
+            sample.m_uv0_ref = { (abcV2*)vbs[0].uv0, (size_t)splits[0].vertex_count };
+            sample.m_direct |= aiPolyMeshAttr_UV0;
+        }
+        else {
+            Lerp(sample.m_uv0_int, v1, v2, m_current_time_offset);
+            sample.m_uv0_ref = sample.m_uv0_int;
+        }
     }
 
     // uv1
     if (summary.interpolate_uv1) {
-        Lerp(sample.m_uv1_int, sample.m_uv1, sample.m_uv12, m_current_time_offset);
-        sample.m_uv1_ref = sample.m_uv1_int;
+        IArray<abcV2> v1 = baked ? getBakedFrame(m_baked_uv1, idx) : IArray<abcV2>(sample.m_uv1);
+        IArray<abcV2> v2 = baked ? getBakedFrame(m_baked_uv1, idx + 1) : has2 ? IArray<abcV2>(sample.m_uv12) : v1;
+        if (direct_uv1 && v1.size() == v2.size() && (int)v1.size() == topology.m_vertex_count) {
+            LerpToSplits(vbs, &aiPolyMeshData::uv1, splits, v1, v2, m_current_time_offset);
+            sample.m_uv1_ref = { (abcV2*)vbs[0].uv1, (size_t)splits[0].vertex_count };
+            sample.m_direct |= aiPolyMeshAttr_UV1;
+        }
+        else {
+            Lerp(sample.m_uv1_int, v1, v2, m_current_time_offset);
+            sample.m_uv1_ref = sample.m_uv1_int;
+        }
     }
 
     // colors
     if (summary.interpolate_colors) {
-        Lerp(sample.m_colors_int, sample.m_colors, sample.m_colors2, m_current_time_offset);
-        sample.m_colors_ref = sample.m_colors_int;
+        IArray<abcC4> v1 = baked ? getBakedFrame(m_baked_colors, idx) : IArray<abcC4>(sample.m_colors);
+        IArray<abcC4> v2 = baked ? getBakedFrame(m_baked_colors, idx + 1) : has2 ? IArray<abcC4>(sample.m_colors2) : v1;
+        if (direct_colors && v1.size() == v2.size() && (int)v1.size() == topology.m_vertex_count) {
+            LerpToSplits(vbs, &aiPolyMeshData::colors, splits, v1, v2, m_current_time_offset);
+            sample.m_colors_ref = { (abcC4*)vbs[0].colors, (size_t)splits[0].vertex_count };
+            sample.m_direct |= aiPolyMeshAttr_Colors;
+        }
+        else {
+            Lerp(sample.m_colors_int, v1, v2, m_current_time_offset);
+            sample.m_colors_ref = sample.m_colors_int;
+        }
+    }
+
+    if (sample.m_direct)
+        sample.m_direct_vbs = vbs;
+    else
+        sample.m_direct_vbs.clear();
+
+    // dirty bits for the client. interpolated attributes change whenever the time does
+    if (sample.m_topology_changed) {
+        sample.m_dirty = aiPolyMeshAttr_All;
     }
+    else {
+        uint32_t dirty = 0;
+        if (m_sample_index_changed) {
+            if (m_shared->constant_points.empty() && !points_unchanged)
+                dirty |= aiPolyMeshAttr_Points;
+            if (m_shared->constant_velocities.empty() && !velocities_unchanged)
+                dirty |= aiPolyMeshAttr_Velocities;
+            if (m_shared->constant_normals.empty() && !(summary.compute_normals ? gen_normals_unchanged : normals_unchanged))
+                dirty |= aiPolyMeshAttr_Normals;
+            if (m_shared->constant_tangents.empty() && summary.compute_tangents && !gen_tangents_unchanged)
+                dirty |= aiPolyMeshAttr_Tangents;
+            if (m_shared->constant_uv0.empty() && !uv0_unchanged)
+                dirty |= aiPolyMeshAttr_UV0;
+            if (m_shared->constant_uv1.empty() && !uv1_unchanged)
+                dirty |= aiPolyMeshAttr_UV1;
+            if (m_shared->constant_colors.empty() && !colors_unchanged)
+                dirty |= aiPolyMeshAttr_Colors;
+        }
+        if (summary.interpolate_points)
+            dirty |= aiPolyMeshAttr_Points | aiPolyMeshAttr_Velocities;
+        if ((summary.interpolate_points || summary.interpolate_normals) && m_shared->constant_normals.empty())
+            dirty |= aiPolyMeshAttr_Normals;
+        if (summary.compute_tangents && !tangents_cacheable)
+            dirty |= aiPolyMeshAttr_Tangents;
+        if (summary.interpolate_uv0)
+            dirty |= aiPolyMeshAttr_UV0;
+        if (summary.interpolate_uv1)
+            dirty |= aiPolyMeshAttr_UV1;
+        if (summary.interpolate_colors)
+            dirty |= aiPolyMeshAttr_Colors;
+        sample.m_dirty = dirty;
+    }
+    m_unfilled |= sample.m_dirty;
+
+    if (m_sample_index_changed) {
+        // baked data is not in the sample's buffers
+        m_cooked_keys = baked ? aiPolyMeshKeys() : keys;
+        m_cooked_normals_generated = !baked && summary.compute_normals && normals_cacheable && !sample.m_normals.empty();
+        m_cooked_tangents_generated = !baked && summary.compute_tangents && tangents_cacheable && !sample.m_tangents.empty();
+    }
+
+    if (m_sample_index_changed && !cached && !baked)
+        storeCachedSample(sample);
+    if (sample.m_topology_changed && !m_varying_topology)
+        publishSharedData();
+}
+
+void aiPolyMesh::carryOverSample(Sample& dst, Sample& prev)
+{
+    // previous interpolated points are needed to compute velocities
+    dst.m_points_int.swap(prev.m_points_int);
+
+    // cooked buffers are kept as they are for attributes whose source is unchanged
+    dst.m_points.swap(prev.m_points);
+    dst.m_velocities.swap(prev.m_velocities);
+    dst.m_normals.swap(prev.m_normals);
+    dst.m_tangents.swap(prev.m_tangents);
+    dst.m_uv0.swap(prev.m_uv0);
+    dst.m_uv1.swap(prev.m_uv1);
+    dst.m_colors.swap(prev.m_colors);
 }
 
 void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
@@ -754,21 +1623,24 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
     bool has_valid_uv0 = false;
     bool has_valid_uv1 = false;
     bool has_valid_colors = false;
+    MeshRefiner::Attribute<abcV3> normals;
+    MeshRefiner::Attribute<abcV2> uv0, uv1;
+    MeshRefiner::Attribute<abcC4> colors;
 
     if (sample.m_normals_sp.valid() && !summary.compute_normals) {
         IArray<abcV3> src{ sample.m_normals_sp.getVals()->get(), sample.m_normals_sp.getVals()->size() };
-        auto& dst = summary.constant_normals ? m_constant_normals : sample.m_normals;
+        auto& dst = summary.constant_normals ? m_shared->constant_normals : sample.m_normals;
 
         has_valid_normals = true;
         if (sample.m_normals_sp.isIndexed() && sample.m_normals_sp.getIndices()->size() == refiner.indices.size()) {
             IArray<int> indices{ (int*)sample.m_normals_sp.getIndices()->get(), sample.m_normals_sp.getIndices()->size() };
-            refiner.addIndexedAttribute<abcV3>(src, indices, dst, topology.m_remap_normals);
+            normals.assign(src, indices, dst, topology.m_remap_normals);
         }
         else if (src.size() == refiner.indices.size()) {
-            refiner.addExpandedAttribute<abcV3>(src, dst, topology.m_remap_normals);
+            normals.assign(src, {}, dst, topology.m_remap_normals);
         }
         else if (src.size() == refiner.points.size()) {
-            refiner.addIndexedAttribute<abcV3>(src, refiner.indices, dst, topology.m_remap_normals);
+            normals.assign(src, refiner.indices, dst, topology.m_remap_normals);
         }
         else {
             DebugLog("Invalid attribute");
@@ -778,18 +1650,18 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
 
     if (sample.m_uv0_sp.valid()) {
         IArray<abcV2> src{ sample.m_uv0_sp.getVals()->get(), sample.m_uv0_sp.getVals()->size() };
-        auto& dst = summary.constant_uv0 ? m_constant_uv0 : sample.m_uv0;
+        auto& dst = summary.constant_uv0 ? m_shared->constant_uv0 : sample.m_uv0;
 
         has_valid_uv0 = true;
         if (sample.m_uv0_sp.isIndexed() && sample.m_uv0_sp.getIndices()->size() == refiner.indices.size()) {
             IArray<int> indices{ (int*)sample.m_uv0_sp.getIndices()->get(), sample.m_uv0_sp.getIndices()->size() };
-            refiner.addIndexedAttribute<abcV2>(src, indices, dst, topology.m_remap_uv0);
+            uv0.assign(src, indices, dst, topology.m_remap_uv0);
         }
         else if (src.size() == refiner.indices.size()) {
-            refiner.addExpandedAttribute<abcV2>(src, dst, topology.m_remap_uv0);
+            uv0.assign(src, {}, dst, topology.m_remap_uv0);
         }
         else if (src.size() == refiner.points.size()) {
-            refiner.addIndexedAttribute<abcV2>(src, refiner.indices, dst, topology.m_remap_uv0);
+            uv0.assign(src, refiner.indices, dst, topology.m_remap_uv0);
         }
         else {
             DebugLog("Invalid attribute");
@@ -799,18 +1671,18 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
 
     if (sample.m_uv1_sp.valid()) {
         IArray<abcV2> src{ sample.m_uv1_sp.getVals()->get(), sample.m_uv1_sp.getVals()->size() };
-        auto& dst = summary.constant_uv1 ? m_constant_uv1 : sample.m_uv1;
+        auto& dst = summary.constant_uv1 ? m_shared->constant_uv1 : sample.m_uv1;
 
         has_valid_uv1 = true;
         if (sample.m_uv1_sp.isIndexed() && sample.m_uv1_sp.getIndices()->size() == refiner.indices.size()) {
             IArray<int> uv1_indices{ (int*)sample.m_uv1_sp.getIndices()->get(), sample.m_uv1_sp.getIndices()->size() };
-            refiner.addIndexedAttribute<abcV2>(src, uv1_indices, dst, topology.m_remap_uv1);
+            uv1.assign(src, uv1_indices, dst, topology.m_remap_uv1);
         }
         else if (src.size() == refiner.indices.size()) {
-            refiner.addExpandedAttribute<abcV2>(src, dst, topology.m_remap_uv1);
+            uv1.assign(src, {}, dst, topology.m_remap_uv1);
         }
         else if (src.size() == refiner.points.size()) {
-            refiner.addIndexedAttribute<abcV2>(src, refiner.indices, dst, topology.m_remap_uv1);
+            uv1.assign(src, refiner.indices, dst, topology.m_remap_uv1);
         }
         else {
             DebugLog("Invalid attribute");
@@ -820,18 +1692,18 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
 
     if (sample.m_colors_sp.valid()) {
         IArray<abcC4> src{ sample.m_colors_sp.getVals()->get(), sample.m_colors_sp.getVals()->size() };
-        auto& dst = summary.constant_colors ? m_constant_colors : sample.m_colors;
+        auto& dst = summary.constant_colors ? m_shared->constant_colors : sample.m_colors;
 
         has_valid_colors = true;
         if (sample.m_colors_sp.isIndexed() && sample.m_colors_sp.getIndices()->size() == refiner.indices.size()) {
             IArray<int> colors_indices{ (int*)sample.m_colors_sp.getIndices()->get(), sample.m_colors_sp.getIndices()->size() };
-            refiner.addIndexedAttribute<abcC4>(src, colors_indices, dst, topology.m_remap_colors);
+            colors.assign(src, colors_indices, dst, topology.m_remap_colors);
         }
         else if (src.size() == refiner.indices.size()) {
-            refiner.addExpandedAttribute<abcC4>(src, dst, topology.m_remap_colors);
+            colors.assign(src, {}, dst, topology.m_remap_colors);
         }
         else if (src.size() == refiner.points.size()) {
-            refiner.addIndexedAttribute<abcC4>(src, refiner.indices, dst, topology.m_remap_colors);
+            colors.assign(src, refiner.indices, dst, topology.m_remap_colors);
         }
         else {
             DebugLog("Invalid attribute");
@@ -840,7 +1712,7 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
     }
 
 
-    refiner.refine();
+    refiner.refineHashed(normals, uv0, uv1, colors);
     refiner.retopology(config.swap_face_winding);
 
     // generate submeshes
@@ -871,17 +1743,21 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
 
     topology.m_remap_points.swap(refiner.new2old_points);
     {
-        auto& points = summary.constant_points ? m_constant_points : sample.m_points;
+        auto& points = summary.constant_points ? m_shared->constant_points : sample.m_points;
         points.swap((RawVector<abcV3>&)refiner.new_points);
-        if (config.swap_handedness)
-            SwapHandedness(points.data(), (int)points.size());
-        if (config.scale_factor != 1.0f)
-            ApplyScale(points.data(), (int)points.size(), config.scale_factor);
+        if (config.swap_handedness || config.scale_factor != 1.0f)
+            RemapTransform(points.data(), points.data(), nullptr, (int)points.size(), config.swap_handedness, config.scale_factor);
         sample.m_points_ref = points;
     }
 
+    // m_shared may be adopted by other contexts after this cook. they only read it
+    if (summary.constant_velocities && !summary.compute_velocities && summary.has_velocities_prop && sample.m_velocities_sp) {
+        RemapTransform(m_shared->constant_velocities, *sample.m_velocities_sp, topology.m_remap_points, config.swap_handedness, config.scale_factor);
+        sample.m_velocities_ref = m_shared->constant_velocities;
+    }
+
     if (has_valid_normals) {
-        sample.m_normals_ref = !m_constant_normals.empty() ? m_constant_normals : sample.m_normals;
+        sample.m_normals_ref = !m_shared->constant_normals.empty() ? m_shared->constant_normals : sample.m_normals;
         if (config.swap_handedness)
             SwapHandedness(sample.m_normals_ref.data(), (int)sample.m_normals_ref.size());
     }
@@ -890,35 +1766,435 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
     }
 
     if (has_valid_uv0)
-        sample.m_uv0_ref = !m_constant_uv0.empty() ? m_constant_uv0 : sample.m_uv0;
+        sample.m_uv0_ref = !m_shared->constant_uv0.empty() ? m_shared->constant_uv0 : sample.m_uv0;
     else
         sample.m_uv0_ref.reset();
 
     if (has_valid_uv1)
-        sample.m_uv1_ref = !m_constant_uv1.empty() ? m_constant_uv1 : sample.m_uv1;
+        sample.m_uv1_ref = !m_shared->constant_uv1.empty() ? m_shared->constant_uv1 : sample.m_uv1;
     else
         sample.m_uv1_ref.reset();
 
     if (has_valid_colors)
-        sample.m_colors_ref = !m_constant_colors.empty() ? m_constant_colors : sample.m_colors;
+        sample.m_colors_ref = !m_shared->constant_colors.empty() ? m_shared->constant_colors : sample.m_colors;
     else
         sample.m_colors_ref.reset();
 
     if (summary.constant_normals && summary.compute_normals) {
         const auto &indices = topology.m_refiner.new_indices_tri;
-        m_constant_normals.resize_discard(m_constant_points.size());
-        GenerateNormals(m_constant_normals.data(), m_constant_points.data(), indices.data(), (int)m_constant_points.size(), (int)indices.size() / 3);
-        sample.m_normals_ref = m_constant_normals;
+        m_shared->constant_normals.resize_discard(m_shared->constant_points.size());
+        GenerateNormals(m_shared->constant_normals.data(), m_shared->constant_points.data(), indices.data(), (int)m_shared->constant_points.size(), (int)indices.size() / 3);
+        sample.m_normals_ref = m_shared->constant_normals;
     }
     if (summary.constant_tangents && summary.compute_tangents) {
         const auto &indices = topology.m_refiner.new_indices_tri;
-        m_constant_tangents.resize_discard(m_constant_points.size());
-        GenerateTangents(m_constant_tangents.data(), m_constant_points.data(), m_constant_uv0.data(), m_constant_normals.data(),
-            indices.data(), (int)m_constant_points.size(), (int)indices.size() / 3);
-        sample.m_tangents_ref = m_constant_tangents;
+        m_shared->constant_tangents.resize_discard(m_shared->constant_points.size());
+        GenerateTangents(m_shared->constant_tangents.data(), m_shared->constant_points.data(), m_shared->constant_uv0.data(), m_shared->constant_normals.data(),
+            indices.data(), (int)m_shared->constant_points.size(), (int)indices.size() / 3);
+        sample.m_tangents_ref = m_shared->constant_tangents;
+    }
+
+    // other velocities are done in later part of cookSampleBody()
+}
+
+template<class Property>
+static bool AddTopologyKey(aiMeshTopologyKey& dst, Property prop, const abcSampleSelector& ss, bool digest)
+{
+    aiArrayKey key;
+    if (!GetArrayKey(key, prop, ss))
+        return false;
+    dst.push_back(key.size);
+    if (digest) {
+        dst.push_back(key.digest[0]);
+        dst.push_back(key.digest[1]);
+    }
+    return true;
+}
+
+template<class Param>
+static bool AddTopologyKey(aiMeshTopologyKey& dst, Param& param, const abcSampleSelector& ss)
+{
+    // corners are welded by comparing attribute values, so how an attribute is remapped depends on its values too
+    if (param.isIndexed() && !AddTopologyKey(dst, param.getIndexProperty(), ss, true))
+        return false;
+    return AddTopologyKey(dst, param.getValueProperty(), ss, true);
+}
+
+bool aiPolyMesh::getTopologyKey(aiMeshTopologyKey& dst, const abcSampleSelector& ss)
+{
+    // face sets would need digests of their own. such meshes are refined every time as before
+    auto& summary = m_summary;
+    if (!summary.has_counts || !summary.has_indices || !m_facesets.empty())
+        return false;
+
+    dst.clear();
+    bool ok =
+        AddTopologyKey(dst, m_schema.getFaceCountsProperty(), ss, true) &&
+        AddTopologyKey(dst, m_schema.getFaceIndicesProperty(), ss, true) &&
+        AddTopologyKey(dst, m_schema.getPositionsProperty(), ss, false);
+    if (ok && summary.has_normals_prop && !summary.compute_normals) {
+        auto param = m_schema.getNormalsParam();
+        ok = AddTopologyKey(dst, param, ss);
+    }
+    if (ok && summary.has_uv0_prop) {
+        auto param = m_schema.getUVsParam();
+        ok = AddTopologyKey(dst, param, ss);
+    }
+    if (ok && summary.has_uv1_prop)
+        ok = AddTopologyKey(dst, m_uv1_param, ss);
+    if (ok && summary.has_colors_prop)
+        ok = AddTopologyKey(dst, m_colors_param, ss);
+
+    if (!ok)
+        dst.clear();
+    return ok;
+}
+
+TopologyPtr aiPolyMesh::findTopology(const aiMeshTopologyKey& key)
+{
+    std::lock_guard<std::mutex> lock(m_topology_cache_mutex);
+    for (auto& record : m_topology_cache) {
+        if (record.key == key)
+            return record.topology;
+    }
+    return nullptr;
+}
+
+void aiPolyMesh::touchTopology(const aiMeshTopologyKey& key, const TopologyPtr& topology)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_topology_cache_mutex);
+        for (auto it = m_topology_cache.begin(); it != m_topology_cache.end(); ++it) {
+            if (it->key == key) {
+                m_topology_cache.splice(m_topology_cache.begin(), m_topology_cache, it);
+                return;
+            }
+        }
+    }
+    // evicted since the read
+    storeTopology(key, topology);
+}
+
+void aiPolyMesh::storeTopology(const aiMeshTopologyKey& key, const TopologyPtr& topology)
+{
+    const size_t capacity = 8;
+
+    std::lock_guard<std::mutex> lock(m_topology_cache_mutex);
+    m_topology_cache.push_front({ key, topology });
+    while (m_topology_cache.size() > capacity)
+        m_topology_cache.pop_back();
+}
+
+void aiPolyMesh::clearTopologyCache()
+{
+    std::lock_guard<std::mutex> lock(m_topology_cache_mutex);
+    m_topology_cache.clear();
+}
+
+aiPolyMeshCachedSamplePtr aiPolyMesh::findCachedSample(const aiMeshTopology& topology, int64_t idx)
+{
+    auto& cache = getContext()->getSampleCache();
+    if (m_varying_topology || !cache.enabled())
+        return nullptr;
+
+    auto ret = std::static_pointer_cast<aiPolyMeshCachedSample>(cache.find(this, idx));
+    if (!ret)
+        return nullptr;
+
+    // scale and handedness are baked into cached data
+    auto& config = getConfig();
+    if (ret->m_vertex_count != topology.m_vertex_count ||
+        ret->m_scale_factor != config.scale_factor ||
+        ret->m_swap_handedness != config.swap_handedness)
+        return nullptr;
+    return ret;
+}
+
+void aiPolyMesh::storeCachedSample(aiPolyMeshSample& sample)
+{
+    auto& cache = getContext()->getSampleCache();
+    auto& topology = *sample.m_topology;
+    if (m_varying_topology || !cache.enabled() || sample.m_sample_index < 0 || topology.m_vertex_count == 0)
+        return;
+
+    auto& config = getConfig();
+    auto& summary = m_summary;
+    bool normals_cacheable = !summary.interpolate_points;
+    bool tangents_cacheable = !summary.interpolate_points && !summary.interpolate_normals && !summary.interpolate_uv0;
+
+    auto data = std::make_shared<aiPolyMeshCachedSample>();
+    data->m_scale_factor = config.scale_factor;
+    data->m_swap_handedness = config.swap_handedness;
+    data->m_vertex_count = topology.m_vertex_count;
+
+    if (m_shared->constant_points.empty())
+        data->m_points = sample.m_points;
+    if (!summary.compute_velocities && summary.has_velocities_prop && !summary.constant_velocities)
+        data->m_velocities = sample.m_velocities;
+    if (m_shared->constant_normals.empty() && (summary.compute_normals ? normals_cacheable : summary.has_normals_prop))
+        data->m_normals = sample.m_normals;
+    if (m_shared->constant_tangents.empty() && summary.compute_tangents && tangents_cacheable)
+        data->m_tangents = sample.m_tangents;
+    if (m_shared->constant_uv0.empty() && summary.has_uv0_prop)
+        data->m_uv0 = sample.m_uv0;
+    if (m_shared->constant_uv1.empty() && summary.has_uv1_prop)
+        data->m_uv1 = sample.m_uv1;
+    if (m_shared->constant_colors.empty() && summary.has_colors_prop)
+        data->m_colors = sample.m_colors;
+
+    cache.store(this, sample.m_sample_index, data);
+}
+
+bool aiPolyMesh::isBaked(const aiMeshTopology& topology, int64_t idx) const
+{
+    if (idx < m_baked_begin || idx > m_baked_end)
+        return false;
+
+    // scale and handedness are baked too
+    auto& config = getConfig();
+    if (m_baked_vertex_count != topology.m_vertex_count ||
+        m_baked_scale_factor != config.scale_factor ||
+        m_baked_swap_handedness != config.swap_handedness)
+        return false;
+
+    // interpolation needs the next sample too
+    auto& summary = m_summary;
+    bool interpolate = summary.interpolate_points || summary.interpolate_normals || summary.interpolate_uv0 ||
+        summary.interpolate_uv1 || summary.interpolate_colors;
+    return !interpolate || std::min(idx + 1, m_num_samples - 1) <= m_baked_end;
+}
+
+void aiPolyMesh::updateAndFill(const abcSampleSelector& ss, const aiPolyMeshBatchRecord& rec, aiPolyMeshBatchResult& dst)
+{
+    dst = aiPolyMeshBatchResult();
+
+    // not forced update unlike aiSchemaUpdateSample(). unchanged samples are skipped and read-ahead keeps working.
+    markForceSync();
+    updateSample(ss);
+
+    auto *sample = getSample();
+    if (!sample)
+        return;
+    dst.visibility = sample->visibility;
+    if (!isDataUpdated()) {
+        dst.status = aiBatchStatus::NotUpdated;
+        return;
+    }
+
+    auto& refiner = sample->m_topology->m_refiner;
+    bool fits = !sample->m_topology_changed &&
+        (int)refiner.splits.size() == rec.split_count &&
+        (int)refiner.submeshes.size() == rec.submesh_count;
+    for (int i = 0; fits && i < rec.split_count; ++i)
+        fits = refiner.splits[i].vertex_count <= rec.vbs[i].vertex_count;
+    for (int i = 0; fits && i < rec.submesh_count; ++i)
+        fits = refiner.submeshes[i].index_count <= rec.ibs[i].index_count;
+    if (!fits) {
+        dst.status = aiBatchStatus::NeedsResize;
+        return;
+    }
+
+    sample->markForceSync();
+    dst.changed = sample->fillVertexBuffer(rec.vbs, rec.ibs);
+    sample->waitAsync();
+    dst.status = aiBatchStatus::Filled;
+}
+
+void aiPolyMesh::bakeRange(const abcSampleSelector& begin, const abcSampleSelector& end)
+{
+    clearBake();
+    if (!m_enabled || m_constant || m_varying_topology)
+        return;
+
+    // remap tables are made by the first cook
+    if (!m_sample) {
+        markForceSync();
+        updateSample(begin);
+        waitAsync();
+        waitPrefetch();
+    }
+
+    auto& topology = *m_shared->topology;
+    auto& config = getConfig();
+    auto& summary = m_summary;
+    int vertex_count = topology.m_vertex_count;
+    int64_t begin_index = getSampleIndex(begin);
+    int64_t end_index = getSampleIndex(end);
+    if (vertex_count == 0 || end_index < begin_index)
+        return;
+
+    // same conditions as aiPolyMeshCachedSample
+    bool normals_cacheable = !summary.interpolate_points;
+    bool tangents_cacheable = !summary.interpolate_points && !summary.interpolate_normals && !summary.interpolate_uv0;
+    bool bake_points = summary.has_points && m_shared->constant_points.empty();
+    bool bake_velocities = !summary.compute_velocities && summary.has_velocities_prop && !summary.constant_velocities;
+    bool bake_normals = m_shared->constant_normals.empty() && (summary.compute_normals ? normals_cacheable : summary.has_normals_prop);
+    bool bake_tangents = m_shared->constant_tangents.empty() && summary.compute_tangents && tangents_cacheable;
+    bool bake_uv0 = m_shared->constant_uv0.empty() && summary.has_uv0_prop;
+    bool bake_uv1 = m_shared->constant_uv1.empty() && summary.has_uv1_prop;
+    bool bake_colors = m_shared->constant_colors.empty() && summary.has_colors_prop;
+
+    size_t num_frames = (size_t)(end_index - begin_index + 1);
+    size_t total = num_frames * vertex_count;
+    if (bake_points) m_baked_points.resize_discard(total);
+    if (bake_velocities) m_baked_velocities.resize_discard(total);
+    if (bake_normals) m_baked_normals.resize_discard(total);
+    if (bake_tangents) m_baked_tangents.resize_discard(total);
+    if (bake_uv0) m_baked_uv0.resize_discard(total);
+    if (bake_uv1) m_baked_uv1.resize_discard(total);
+    if (bake_colors) m_baked_colors.resize_discard(total);
+
+    const auto &indices = topology.m_refiner.new_indices_tri;
+    Abc::P3fArraySamplePtr points_sp;
+    Abc::V3fArraySamplePtr velocities_sp;
+    AbcGeom::IN3fGeomParam::Sample normals_sp;
+    AbcGeom::IV2fGeomParam::Sample uv0_sp, uv1_sp;
+    AbcGeom::IC4fGeomParam::Sample colors_sp;
+
+    bool ok = true;
+    for (size_t fi = 0; fi < num_frames && ok; ++fi) {
+        auto ss = aiIndexToSampleSelector(begin_index + (int64_t)fi);
+        size_t offset = fi * vertex_count;
+
+        abcV3 *points = bake_points ? &m_baked_points[offset] : m_shared->constant_points.data();
+        if (bake_points) {
+            m_schema.getPositionsProperty().get(points_sp, ss);
+            ok = ok && RemapTransformFrame(m_baked_points, fi, *points_sp, topology.m_remap_points, vertex_count,
+                config.swap_handedness, config.scale_factor);
+        }
+
+        if (bake_velocities) {
+            m_schema.getVelocitiesProperty().get(velocities_sp, ss);
+            ok = ok && RemapTransformFrame(m_baked_velocities, fi, *velocities_sp, topology.m_remap_points, vertex_count,
+                config.swap_handedness, config.scale_factor);
+        }
+
+        abcV2 *uv0 = bake_uv0 ? &m_baked_uv0[offset] : m_shared->constant_uv0.data();
+        if (bake_uv0) {
+            m_schema.getUVsParam().getIndexed(uv0_sp, ss);
+            ok = ok && RemapFrame(m_baked_uv0, fi, *uv0_sp.getVals(), topology.m_remap_uv0, vertex_count);
+        }
+        if (bake_uv1) {
+            m_uv1_param.getIndexed(uv1_sp, ss);
+            ok = ok && RemapFrame(m_baked_uv1, fi, *uv1_sp.getVals(), topology.m_remap_uv1, vertex_count);
+        }
+        if (bake_colors) {
+            m_colors_param.getIndexed(colors_sp, ss);
+            ok = ok && RemapFrame(m_baked_colors, fi, *colors_sp.getVals(), topology.m_remap_colors, vertex_count);
+        }
+
+        abcV3 *normals = bake_normals ? &m_baked_normals[offset] : m_shared->constant_normals.data();
+        if (bake_normals && ok) {
+            if (summary.compute_normals && !points) {
+                ok = false;
+            }
+            else if (summary.compute_normals) {
+                GenerateNormals(normals, points, indices.data(), vertex_count, (int)indices.size() / 3);
+            }
+            else {
+                m_schema.getNormalsParam().getIndexed(normals_sp, ss);
+                ok = RemapTransformFrame(m_baked_normals, fi, *normals_sp.getVals(), topology.m_remap_normals, vertex_count,
+                    config.swap_handedness, 1.0f);
+            }
+        }
+
+        if (bake_tangents && ok) {
+            if (!points || !uv0 || !normals) {
+                ok = false;
+            }
+            else {
+                GenerateTangents(&m_baked_tangents[offset], points, uv0, normals,
+                    indices.data(), vertex_count, (int)indices.size() / 3);
+            }
+        }
+    }
+
+    if (!ok) {
+        DebugLog("aiPolyMesh::bakeRange(): sample doesn't match the topology");
+        releaseBake();
+        return;
+    }
+
+    m_baked_begin = begin_index;
+    m_baked_end = end_index;
+    m_baked_vertex_count = vertex_count;
+    m_baked_scale_factor = config.scale_factor;
+    m_baked_swap_handedness = config.swap_handedness;
+}
+
+void aiPolyMesh::clearBake()
+{
+    waitAsync();
+    waitPrefetch();
+    clearPrefetch();
+    releaseBake();
+
+    // samples that skipped reading because they were baked must be read again
+    m_last_sample_index = -1;
+}
+
+void aiPolyMesh::releaseBake()
+{
+    // swap with empty ones to release memory
+    RawVector<abcV3>().swap(m_baked_points);
+    RawVector<abcV3>().swap(m_baked_velocities);
+    RawVector<abcV3>().swap(m_baked_normals);
+    RawVector<abcV4>().swap(m_baked_tangents);
+    RawVector<abcV2>().swap(m_baked_uv0);
+    RawVector<abcV2>().swap(m_baked_uv1);
+    RawVector<abcC4>().swap(m_baked_colors);
+    m_baked_begin = 0;
+    m_baked_end = -1;
+    m_baked_vertex_count = 0;
+}
+
+// registry of published aiPolyMeshSharedData. keyed by aiContext::getSharingKey() + full name of the mesh
+static std::mutex s_shared_mutex;
+static std::map<std::string, std::weak_ptr<aiPolyMeshSharedData>> s_shared_data;
+
+void aiPolyMesh::acquireSharedData()
+{
+    m_shared_key = getContext()->getSharingKey() + '\n' + getFullName();
+
+    std::lock_guard<std::mutex> lock(s_shared_mutex);
+    auto it = s_shared_data.find(m_shared_key);
+    if (it == s_shared_data.end())
+        return;
+    if (auto shared = it->second.lock()) {
+        m_shared = shared;
+        m_shared_published = true;
+        m_shared_adopted = true;
+        // the topology is already built. forcing update would clear it
+        m_force_update = false;
+    }
+}
+
+void aiPolyMesh::publishSharedData()
+{
+    if (m_shared_published || m_shared_key.empty() || m_shared->topology->m_vertex_count == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(s_shared_mutex);
+    auto& slot = s_shared_data[m_shared_key];
+    if (slot.expired()) {
+        slot = m_shared;
+        m_shared_published = true;
+    }
+}
+
+void aiPolyMesh::releaseSharedData()
+{
+    if (!m_shared_published) {
+        m_shared.reset();
+        return;
     }
 
-    // velocities are done in later part of cookSampleBody()
+    std::lock_guard<std::mutex> lock(s_shared_mutex);
+    m_shared.reset();
+    m_shared_published = false;
+    auto it = s_shared_data.find(m_shared_key);
+    if (it != s_shared_data.end() && it->second.expired())
+        s_shared_data.erase(it);
 }
 
 void aiPolyMesh::onTopologyDetermined()
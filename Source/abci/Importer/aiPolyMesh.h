@@ -1,5 +1,6 @@
 #pragma once
 #include "aiMeshOps.h"
+#include "aiSampleCache.h"
 
 using abcFaceSetSchemas = std::vector<AbcGeom::IFaceSetSchema>;
 using abcFaceSetSamples = std::vector<AbcGeom::IFaceSetSchema::Sample>;
@@ -54,6 +55,69 @@ public:
 };
 using TopologyPtr = std::shared_ptr<aiMeshTopology>;
 
+// digests of the arrays a refined topology is made from (see aiPolyMesh::getTopologyKey())
+using aiMeshTopologyKey = std::vector<uint64_t>;
+
+// ArraySampleKey of an attribute's source array. keys that failed to be read never match.
+struct aiArrayKey
+{
+    uint64_t size = 0;
+    uint64_t digest[2] = {};
+    bool valid = false;
+
+    bool operator==(const aiArrayKey& v) const
+    {
+        return valid && v.valid && size == v.size && digest[0] == v.digest[0] && digest[1] == v.digest[1];
+    }
+};
+
+struct aiPolyMeshKeys
+{
+    aiArrayKey points, velocities, normals, uv0, uv1, colors;
+};
+
+
+// topology and constant vertex data of a mesh. published after the first cook and then shared by the same mesh
+// in all contexts that load the same path with the same import config (see aiContext::getSharingKey()).
+// published data is read only.
+class aiPolyMeshSharedData
+{
+public:
+    aiPolyMeshSharedData() : topology(new aiMeshTopology()) {}
+
+    TopologyPtr topology;
+    RawVector<abcV3> constant_points;
+    RawVector<abcV3> constant_velocities;
+    RawVector<abcV3> constant_normals;
+    RawVector<abcV4> constant_tangents;
+    RawVector<abcV2> constant_uv0;
+    RawVector<abcV2> constant_uv1;
+    RawVector<abcC4> constant_colors;
+};
+using aiPolyMeshSharedDataPtr = std::shared_ptr<aiPolyMeshSharedData>;
+
+
+// remapped vertex data of one sample index (before interpolation).
+// generated normals / tangents are held too if they depend only on that sample.
+class aiPolyMeshCachedSample : public aiCachedSample
+{
+public:
+    size_t getSize() const override;
+
+public:
+    float m_scale_factor = 1.0f;
+    bool m_swap_handedness = false;
+    int m_vertex_count = 0;
+
+    RawVector<abcV3> m_points;
+    RawVector<abcV3> m_velocities;
+    RawVector<abcV3> m_normals;
+    RawVector<abcV4> m_tangents;
+    RawVector<abcV2> m_uv0, m_uv1;
+    RawVector<abcC4> m_colors;
+};
+using aiPolyMeshCachedSamplePtr = std::shared_ptr<aiPolyMeshCachedSample>;
+
 
 class aiPolyMeshSample : public aiSample
 {
@@ -67,10 +131,17 @@ public:
     void getSummary(aiMeshSampleSummary &dst) const;
     void getSplitSummaries(aiMeshSplitSummary  *dst) const;
     void getSubmeshSummaries(aiSubmeshSummary *dst) const;
+    int getIndexSize(int split_index) const;
+    // self bounds of the interpolated sample in the output space. false if the archive doesn't have them
+    bool getSelfBounds(abcV3& bbmin, abcV3& bbmax) const;
 
-    void fillSplitVertices(int split_index, aiPolyMeshData &data) const;
+    // attrs: aiPolyMeshAttributeBits to write
+    void fillSplitVertices(int split_index, aiPolyMeshData &data, uint32_t attrs = aiPolyMeshAttr_All) const;
     void fillSubmeshIndices(int submesh_index, aiSubmeshData &data) const;
-    void fillVertexBuffer(aiPolyMeshData* vbs, aiSubmeshData* ibs);
+    // returns aiPolyMeshAttributeBits written
+    uint32_t fillVertexBuffer(aiPolyMeshData* vbs, aiSubmeshData* ibs);
+    // copies attributes written straight into m_direct_vbs to the sample's own buffers so that they can be replaced
+    void detachDirectBuffers();
 
     void waitAsync() override;
 
@@ -81,7 +152,7 @@ public:
     AbcGeom::IV2fGeomParam::Sample m_uv0_sp, m_uv0_sp2;
     AbcGeom::IV2fGeomParam::Sample m_uv1_sp, m_uv1_sp2;
     AbcGeom::IC4fGeomParam::Sample m_colors_sp, m_colors_sp2;
-    Abc::Box3d m_bounds;
+    Abc::Box3d m_bounds, m_bounds2; // self bounds of the sample and the next one. empty if the archive has none
 
     IArray<abcV3> m_points_ref;
     IArray<abcV3> m_velocities_ref;
@@ -100,8 +171,17 @@ public:
 
     TopologyPtr m_topology;
     bool m_topology_changed = false;
+    bool m_topology_reused = false; // m_topology came from the topology cache of a heterogeneous mesh or was adopted from another context. no refine needed
+    aiMeshTopologyKey m_topology_key;
+    aiPolyMeshKeys m_keys;  // of source arrays of m_sample_index
+    uint32_t m_dirty = 0;   // aiPolyMeshAttributeBits. attributes changed by the last cook
+    uint32_t m_direct = 0;  // aiPolyMeshAttributeBits. attributes the last cook wrote straight into m_direct_vbs
+    std::vector<aiPolyMeshData> m_direct_vbs;
+
+    aiPolyMeshCachedSamplePtr m_cached, m_cached2; // for m_sample_index and m_sample_index + 1
+    bool m_baked = false; // vertex data come from aiPolyMesh::m_baked_*
 
-    std::future<void> m_async_copy;
+    aiTaskGroup m_async_copy;
 };
 
 
@@ -121,27 +201,105 @@ public:
     const aiMeshSummaryInternal& getSummary() const;
 
     Sample* newSample() override;
-    void readSampleBody(Sample& sample, uint64_t idx) override;
+    void readSampleBody(Sample& sample, uint64_t idx, bool force_update) override;
     void cookSampleBody(Sample& sample) override;
+    void commitSample(Sample& sample) override;
+    bool canTakePrefetchedSample(const Sample& sample) const override;
+    void carryOverSample(Sample& dst, Sample& prev) override;
 
     void onTopologyChange(aiPolyMeshSample& sample);
     void onTopologyDetermined();
 
+    void acquireSharedData();
+    void publishSharedData();
+    void releaseSharedData();
+    // the cook and the fill of the current sample read the vertex buffers and output settings
+    void waitCookAndFill();
+
+    // heterogeneous topology only. refined topologies are kept for recently seen keys
+    bool getTopologyKey(aiMeshTopologyKey& dst, const abcSampleSelector& ss);
+    // doesn't change the LRU order so that read-ahead can look up. touchTopology() does
+    TopologyPtr findTopology(const aiMeshTopologyKey& key);
+    void touchTopology(const aiMeshTopologyKey& key, const TopologyPtr& topology);
+    void storeTopology(const aiMeshTopologyKey& key, const TopologyPtr& topology);
+    void clearTopologyCache();
+
+    aiPolyMeshCachedSamplePtr findCachedSample(const aiMeshTopology& topology, int64_t idx);
+    // reads m_sample_index + 1 for interpolation. called by the cook only when the time is between samples
+    void readSecondSample(Sample& sample);
+    void storeCachedSample(aiPolyMeshSample& sample);
+
+    void updateAndFill(const abcSampleSelector& ss, const aiPolyMeshBatchRecord& rec, aiPolyMeshBatchResult& dst);
+
+    // per split destination buffers that the cook writes per frame outputs into. nullptr / 0 unregisters.
+    void setVertexBuffers(const aiPolyMeshData *vbs, int split_count);
+    const std::vector<aiPolyMeshData>& getVertexBuffers() const;
+    void setVertexFormats(const aiPolyMeshVertexFormats& formats);
+    const aiPolyMeshVertexFormats& getVertexFormats() const;
+    void setIndexFormat(aiIndexFormat format);
+    aiIndexFormat getIndexFormat() const;
+    void setSkipUnchanged(bool v);
+    // attributes changed since the last fill
+    uint32_t getUnfilled() const;
+    // attributes the next fill writes. clears the changes
+    uint32_t takeUnfilled();
+
+    void bakeRange(const abcSampleSelector& begin, const abcSampleSelector& end) override;
+    void clearBake() override;
+    void releaseBake();
+    bool isBaked(const aiMeshTopology& topology, int64_t idx) const;
+    template<class T> IArray<T> getBakedFrame(const RawVector<T>& src, int64_t idx) const;
+
+protected:
+    void updateSampleBody(const abcSampleSelector& ss) override;
+    bool getSelfBounds(const abcSampleSelector& ss, abcBoxd& dst) override;
+    bool skipHiddenSamples() const override;
+
 public:
-    RawVector<abcV3> m_constant_points;
-    RawVector<abcV3> m_constant_velocities;
-    RawVector<abcV3> m_constant_normals;
-    RawVector<abcV4> m_constant_tangents;
-    RawVector<abcV2> m_constant_uv0;
-    RawVector<abcV2> m_constant_uv1;
-    RawVector<abcC4> m_constant_colors;
+    aiPolyMeshSharedDataPtr m_shared;
+
+    // per-frame version of constant_* in m_shared. frame of sample index i starts at (i - m_baked_begin) * m_baked_vertex_count
+    RawVector<abcV3> m_baked_points;
+    RawVector<abcV3> m_baked_velocities;
+    RawVector<abcV3> m_baked_normals;
+    RawVector<abcV4> m_baked_tangents;
+    RawVector<abcV2> m_baked_uv0;
+    RawVector<abcV2> m_baked_uv1;
+    RawVector<abcC4> m_baked_colors;
+    int64_t m_baked_begin = 0;
+    int64_t m_baked_end = -1;
+    int m_baked_vertex_count = 0;
+    float m_baked_scale_factor = 1.0f;
+    bool m_baked_swap_handedness = false;
 
 private:
     aiMeshSummaryInternal m_summary;
     AbcGeom::IV2fGeomParam m_uv1_param;
     AbcGeom::IC4fGeomParam m_colors_param;
 
-    TopologyPtr m_shared_topology;
+    std::string m_shared_key;
+    bool m_shared_published = false;
+    bool m_shared_adopted = false; // m_shared came from another context. its refined topology is not reported yet
     abcFaceSetSchemas m_facesets;
     bool m_varying_topology = false;
+
+    struct TopologyRecord
+    {
+        aiMeshTopologyKey key;
+        TopologyPtr topology;
+    };
+    std::mutex m_topology_cache_mutex;
+    std::list<TopologyRecord> m_topology_cache; // front: most recently used
+    TopologyPtr m_last_topology; // of the last cooked sample
+
+    std::vector<aiPolyMeshData> m_vertex_buffers; // registered by setVertexBuffers()
+    aiPolyMeshVertexFormats m_vertex_formats;
+    aiIndexFormat m_index_format = aiIndexFormat::UInt32;
+    bool m_skip_unchanged = false;
+    std::atomic<uint32_t> m_unfilled{ aiPolyMeshAttr_All }; // aiPolyMeshAttributeBits. m_dirty of the cooks since the last fill
+
+    // keys of the data held in the cooked buffers of the current sample. attributes with the same key are not re-cooked
+    aiPolyMeshKeys m_cooked_keys;
+    bool m_cooked_normals_generated = false;  // m_normals were generated from points of m_cooked_keys.points
+    bool m_cooked_tangents_generated = false;
 };
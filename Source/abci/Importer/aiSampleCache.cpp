@@ -0,0 +1,97 @@
+#include "pch.h"
+#include "aiInternal.h"
+#include "aiSampleCache.h"
+
+
+aiCachedSample::~aiCachedSample()
+{
+}
+
+
+void aiSampleCache::setBudget(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budget = bytes;
+    evict(m_budget);
+}
+
+bool aiSampleCache::enabled() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budget > 0;
+}
+
+aiCachedSamplePtr aiSampleCache::find(const aiSchema *schema, int64_t index)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_table.find(Key(schema, index));
+    if (it == m_table.end()) {
+        ++m_misses;
+        return nullptr;
+    }
+
+    ++m_hits;
+    m_records.splice(m_records.begin(), m_records, it->second);
+    return it->second->data;
+}
+
+void aiSampleCache::store(const aiSchema *schema, int64_t index, const aiCachedSamplePtr& data)
+{
+    size_t size = data->getSize();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (size > m_budget)
+        return;
+
+    Key key(schema, index);
+    auto it = m_table.find(key);
+    if (it != m_table.end()) {
+        m_used -= it->second->size;
+        m_records.erase(it->second);
+        m_table.erase(it);
+    }
+
+    evict(m_budget - size);
+    m_records.push_front({ key, data, size });
+    m_table[key] = m_records.begin();
+    m_used += size;
+}
+
+void aiSampleCache::erase(const aiSchema *schema)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_table.lower_bound(Key(schema, std::numeric_limits<int64_t>::min()));
+    while (it != m_table.end() && it->first.first == schema) {
+        m_used -= it->second->size;
+        m_records.erase(it->second);
+        it = m_table.erase(it);
+    }
+}
+
+void aiSampleCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_records.clear();
+    m_table.clear();
+    m_used = 0;
+}
+
+void aiSampleCache::getStats(aiSampleCacheStats& dst) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    dst.hits = m_hits;
+    dst.misses = m_misses;
+    dst.used_bytes = m_used;
+    dst.budget_bytes = m_budget;
+    dst.entry_count = (int)m_records.size();
+}
+
+void aiSampleCache::evict(size_t budget)
+{
+    while (m_used > budget && !m_records.empty()) {
+        auto& r = m_records.back();
+        m_used -= r.size;
+        m_table.erase(r.key);
+        m_records.pop_back();
+    }
+}
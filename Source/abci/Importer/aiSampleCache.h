@@ -0,0 +1,51 @@
+#pragma once
+
+// cooked data of one sample index. each schema type derives its own.
+class aiCachedSample
+{
+public:
+    virtual ~aiCachedSample();
+    virtual size_t getSize() const = 0;
+};
+using aiCachedSamplePtr = std::shared_ptr<aiCachedSample>;
+
+
+// LRU cache of cooked samples shared by all schemas of a context. keyed by (schema, sample index).
+// entries are shared_ptr so that an evicted entry stays valid while a sample still holds it.
+class aiSampleCache
+{
+public:
+    // in bytes. 0: disabled
+    void setBudget(size_t bytes);
+    bool enabled() const;
+
+    // counts hit / miss and moves the found entry to the front
+    aiCachedSamplePtr find(const aiSchema *schema, int64_t index);
+    // evicts least recently used entries until the budget is met
+    void store(const aiSchema *schema, int64_t index, const aiCachedSamplePtr& data);
+    // erase all entries of the schema. called when its topology changes or it is destroyed
+    void erase(const aiSchema *schema);
+    void clear();
+
+    void getStats(aiSampleCacheStats& dst) const;
+
+private:
+    using Key = std::pair<const aiSchema*, int64_t>;
+    struct Record
+    {
+        Key key;
+        aiCachedSamplePtr data;
+        size_t size;
+    };
+    using Records = std::list<Record>;
+
+    void evict(size_t budget);
+
+    mutable std::mutex m_mutex;
+    Records m_records; // front: most recently used
+    std::map<Key, Records::iterator> m_table;
+    size_t m_budget = 0;
+    size_t m_used = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+};
@@ -37,6 +37,52 @@ bool aiSchema::isConstant() const { return m_constant; }
 bool aiSchema::isDataUpdated() const { return m_data_updated; }
 void aiSchema::markForceUpdate() { m_force_update = true; }
 void aiSchema::markForceSync() { m_force_sync = true; }
+void aiSchema::setCullingMatrix(const abcM44d& m) { m_culling_matrix = m; }
+bool aiSchema::isCulled() const { return m_culled; }
+
+bool aiSchema::isOutOfView(const abcSampleSelector& ss)
+{
+    auto& frustums = getContext()->getViewFrustums();
+    abcBoxd bounds;
+    if (frustums.empty() || !getSelfBounds(ss, bounds))
+        return false;
+
+    // corners in the output space
+    auto& config = getConfig();
+    abcV3 corners[8];
+    for (int i = 0; i < 8; ++i) {
+        abcV3d p(
+            (i & 1) ? bounds.max.x : bounds.min.x,
+            (i & 2) ? bounds.max.y : bounds.min.y,
+            (i & 4) ? bounds.max.z : bounds.min.z);
+        p = p * m_culling_matrix;
+        corners[i] = abcV3((float)p.x, (float)p.y, (float)p.z) * config.scale_factor;
+        if (config.swap_handedness)
+            corners[i].x *= -1.0f;
+    }
+
+    // out of a frustum if all corners are behind one of its planes
+    for (auto& frustum : frustums) {
+        bool inside = true;
+        for (auto& plane : frustum.planes) {
+            abcV3 n(plane.x, plane.y, plane.z);
+            bool all_behind = true;
+            for (auto& c : corners) {
+                if (n.dot(c) + plane.w >= 0.0f) {
+                    all_behind = false;
+                    break;
+                }
+            }
+            if (all_behind) {
+                inside = false;
+                break;
+            }
+        }
+        if (inside)
+            return false;
+    }
+    return true;
+}
 
 int aiSchema::getNumProperties() const
 {
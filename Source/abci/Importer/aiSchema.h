@@ -16,6 +16,8 @@ public:
 
 public:
     bool visibility = true;
+    int64_t m_sample_index = -1;  // read by readSampleBody()
+    int64_t m_sample_index2 = -1; // of the second sample for interpolation. -1 if it is not read
 
 protected:
     aiSchema *m_schema = nullptr;
@@ -32,6 +34,7 @@ public:
     aiSchema(aiObject *parent, const abcObject &abc);
     virtual ~aiSchema();
 
+    virtual int getTimeSamplingIndex() const = 0;
     bool isConstant() const;
     bool isDataUpdated() const;
     void markForceUpdate();
@@ -40,16 +43,33 @@ public:
     aiProperty* getPropertyByIndex(int i);
     aiProperty* getPropertyByName(const std::string& name);
 
+    // cook samples in the range into memory so that later updates in it are only lookup and interpolation
+    virtual void bakeRange(const abcSampleSelector& begin, const abcSampleSelector& end) {}
+    virtual void clearBake() {}
+
+    // culling by aiContext::getViewFrustums(). the matrix places the schema in the space of the top object.
+    void setCullingMatrix(const abcM44d& m);
+    bool isCulled() const;
+
 protected:
     virtual abcProperties getAbcProperties() = 0;
     void setupProperties();
     void updateProperties(const abcSampleSelector& ss);
 
+    // self bounds around the samples that an update at ss interpolates. false if the schema has none
+    virtual bool getSelfBounds(const abcSampleSelector& ss, abcBoxd& dst) { return false; }
+    // true if the self bounds are outside of all view frustums
+    bool isOutOfView(const abcSampleSelector& ss);
+    // true if hidden samples may skip reading and cooking
+    virtual bool skipHiddenSamples() const { return false; }
+
 protected:
     bool m_constant = false;
     bool m_data_updated = false;
     bool m_force_update = false;
     bool m_force_sync = false;
+    bool m_culled = false;
+    abcM44d m_culling_matrix;
     std::vector<aiPropertyPtr> m_properties; // sorted vector
 };
 
@@ -80,7 +100,7 @@ public:
         setupProperties();
     }
 
-    int getTimeSamplingIndex() const
+    int getTimeSamplingIndex() const override
     {
         return getContext()->getTimeSamplingIndex(m_schema.getTimeSampling());
     }
@@ -110,6 +130,7 @@ public:
 
     void updateSample(const abcSampleSelector& ss) override
     {
+        waitPrefetch();
         m_async_load.reset();
         updateSampleBody(ss);
         if (m_async_load.ready())
@@ -118,16 +139,16 @@ public:
 
     virtual void readSample(Sample& sample, uint64_t idx)
     {
-        m_force_update_local = m_force_update;
-
-        auto body = [this, &sample, idx]() {
-            readSampleBody(sample, idx);
+        bool force_update = m_force_update;
+        auto body = [this, &sample, idx, force_update]() {
+            readSampleBody(sample, idx, force_update);
+            commitSample(sample);
         };
 
-        if (m_force_sync || !getConfig().async_load)
-            body();
-        else
+        if (useAsyncLoad())
             m_async_load.m_read = body;
+        else
+            body();
     }
 
     virtual void cookSample(Sample& sample)
@@ -136,10 +157,10 @@ public:
             cookSampleBody(sample);
         };
 
-        if (m_force_sync || !getConfig().async_load)
-            body();
-        else
+        if (useAsyncLoad())
             m_async_load.m_cook = body;
+        else
+            body();
     }
 
     void waitAsync() override
@@ -147,22 +168,55 @@ public:
         m_async_load.wait();
     }
 
+    // read-ahead tasks are not waited in waitAsync() intentionally. they must not block the host.
+    void waitPrefetch()
+    {
+        m_async_load.wait();
+        m_prefetch_tasks.wait();
+    }
+
 protected:
+    // in parallel update mode this is already called from a worker thread
+    bool useAsyncLoad() const
+    {
+        auto& config = getConfig();
+        return !m_force_sync && config.async_load && !config.parallel_update;
+    }
+
     virtual void updateSampleBody(const abcSampleSelector& ss)
     {
         if (!m_enabled)
             return;
 
+        // the sample and the schema state are left as they are. the next update in view reads and cooks.
+        m_culled = m_sample && !m_force_update && isOutOfView(ss);
+        if (m_culled) {
+            m_data_updated = false;
+            m_force_sync = false;
+            return;
+        }
+
         Sample* sample = nullptr;
         int64_t sample_index = getSampleIndex(ss);
         auto& config = getConfig();
+        bool hidden = false;
 
         if (!m_sample || (!m_constant && sample_index != m_last_sample_index) || m_force_update) {
             m_sample_index_changed = true;
             if (!m_sample)
                 m_sample.reset(newSample());
-            sample = m_sample.get();
-            readSample(*sample, sample_index);
+            else if (!m_force_update)
+                // no reads and no cook if hidden. the last cooked data stays for when the sample is visible again
+                hidden = isHiddenSample(sample_index);
+
+            if (!hidden && !m_force_update && takePrefetchedSample(sample_index)) {
+                sample = m_sample.get();
+                commitSample(*sample);
+            }
+            else if (!hidden) {
+                sample = m_sample.get();
+                readSample(*sample, sample_index);
+            }
         }
         else {
             m_sample_index_changed = false;
@@ -201,18 +255,128 @@ protected:
             cookSample(*sample);
             m_data_updated = true;
         }
+        else if (hidden) {
+            // report the change to hidden once
+            m_data_updated = m_sample->visibility;
+            m_sample->visibility = false;
+        }
         else {
             m_data_updated = false;
         }
         updateProperties(ss);
 
-        m_last_sample_index = sample_index;
+        if (m_last_sample_index != -1 && sample_index != m_last_sample_index)
+            m_prefetch_direction = sample_index > m_last_sample_index ? 1 : -1;
+        if (m_force_update)
+            clearPrefetch();
+        else
+            prefetchSamples(sample_index);
+
+        // the sample doesn't hold data of a hidden index. make the next update read again
+        m_last_sample_index = hidden ? -1 : sample_index;
         m_force_update = false;
         m_force_sync = false;
     }
 
-    virtual void readSampleBody(Sample& sample, uint64_t idx) = 0;
+    // also runs for read-ahead samples while the host uses the current one, so this must not change schema state.
+    // force_update: m_force_update at the time the read was requested
+    virtual void readSampleBody(Sample& sample, uint64_t idx, bool force_update) = 0;
     virtual void cookSampleBody(Sample& sample) = 0;
+    // schema state that follows a read is updated here. called only for the sample that becomes the current one,
+    // after readSampleBody() or when it is taken from the read-ahead ring
+    virtual void commitSample(Sample& sample) {}
+    // false if a read-ahead sample is out of date with the schema state (e.g. shared data acquired since the read)
+    virtual bool canTakePrefetchedSample(const Sample& sample) const { return true; }
+
+    // called when a read-ahead sample replaces the current one. move over data the cook needs from the previous frame.
+    virtual void carryOverSample(Sample& dst, Sample& prev) {}
+
+    bool takePrefetchedSample(int64_t sample_index)
+    {
+        for (size_t i = 0; i < m_prefetch_indices.size(); ++i) {
+            if (m_prefetch_indices[i] == sample_index && m_prefetch_samples[i] && canTakePrefetchedSample(*m_prefetch_samples[i])) {
+                std::swap(m_sample, m_prefetch_samples[i]);
+                m_prefetch_indices[i] = -1;
+                carryOverSample(*m_sample, *m_prefetch_samples[i]);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void clearPrefetch()
+    {
+        for (auto& i : m_prefetch_indices)
+            i = -1;
+    }
+
+    // read next samples in playback direction into the ring while the host consumes the current one.
+    // cooking is left to updateSampleBody() because it depends on the time offset and on schema state.
+    void prefetchSamples(int64_t sample_index)
+    {
+        int depth = getConfig().read_ahead_samples;
+        if (depth <= 0 || m_constant || m_num_samples <= 1 || !m_enabled) {
+            m_prefetch_samples.clear();
+            m_prefetch_indices.clear();
+            return;
+        }
+        if ((int)m_prefetch_samples.size() != depth) {
+            m_prefetch_samples.resize(depth);
+            m_prefetch_indices.resize(depth, -1);
+        }
+
+        RawVector<int64_t> wanted;
+        for (int i = 1; i <= depth; ++i) {
+            int64_t idx = sample_index + m_prefetch_direction * i;
+            if (idx < 0 || idx >= m_num_samples)
+                break;
+            wanted.push_back(idx);
+        }
+
+        // keep slots that already hold a wanted index. fill others with the rest.
+        RawVector<int> free_slots;
+        for (int si = 0; si < depth; ++si) {
+            auto it = std::find(wanted.begin(), wanted.end(), m_prefetch_indices[si]);
+            if (it != wanted.end())
+                wanted.erase(it);
+            else
+                free_slots.push_back(si);
+        }
+
+        std::vector<std::pair<Sample*, int64_t>> jobs;
+        for (size_t i = 0; i < wanted.size() && i < free_slots.size(); ++i) {
+            int si = free_slots[i];
+            if (!m_prefetch_samples[si])
+                m_prefetch_samples[si].reset(newSample());
+            m_prefetch_indices[si] = wanted[i];
+            jobs.push_back({ m_prefetch_samples[si].get(), wanted[i] });
+        }
+        if (jobs.empty())
+            return;
+
+        // reads for one schema run in series. different schemas run in parallel.
+        auto body = [this, jobs]() {
+            for (auto& job : jobs) {
+                job.first->waitAsync();
+                // hidden samples are never taken from the ring
+                if (!isHiddenSample(job.second))
+                    readSampleBody(*job.first, job.second, false);
+            }
+        };
+
+        if (useAsyncLoad() && m_async_load.ready()) {
+            // kick after async read & cook of the current sample. they use the same schema state.
+            auto& last = m_async_load.m_cook ? m_async_load.m_cook : m_async_load.m_read;
+            auto prev = last;
+            last = [this, prev, body]() {
+                prev();
+                m_prefetch_tasks.run(body);
+            };
+        }
+        else {
+            m_prefetch_tasks.run(body);
+        }
+    }
 
 
     AbcGeom::ICompoundProperty getAbcProperties() override
@@ -220,6 +384,52 @@ protected:
         return m_schema.getUserProperties();
     }
 
+    // for schemas that have self bounds (IGeomBaseSchema)
+    bool readSelfBounds(const abcSampleSelector& ss, abcBoxd& dst)
+    {
+        auto param = m_schema.getSelfBoundsProperty();
+        if (!param || param.getNumSamples() == 0)
+            return false;
+
+        int64_t idx = getSampleIndex(ss);
+        param.get(dst, aiIndexToSampleSelector(idx));
+        // the next sample is interpolated only if the time is between samples. see updateSampleBody()
+        if (getConfig().interpolate_samples && idx + 1 < m_num_samples &&
+            ss.getRequestedTime() > m_time_sampling->getSampleTime(idx)) {
+            abcBoxd next;
+            param.get(next, aiIndexToSampleSelector(idx + 1));
+            dst.extendBy(next);
+        }
+        return !dst.isEmpty();
+    }
+
+    // reads only the visibility. false if the schema doesn't skip hidden samples
+    bool isHiddenSample(int64_t idx)
+    {
+        if (!skipHiddenSamples() || !m_visibility_prop.valid() || m_visibility_prop.getNumSamples() == 0)
+            return false;
+        int8_t v;
+        m_visibility_prop.get(v, aiIndexToSampleSelector(idx));
+        return v == 0;
+    }
+
+    // the second sample for interpolation is read by the cook only when the time is between samples.
+    // readSampleBody() takes it as the first sample when playback advances by one.
+    bool needsSecondSample(const Sample& sample) const
+    {
+        return m_current_time_offset != 0 && !hasSecondSample(sample);
+    }
+
+    bool hasSecondSample(const Sample& sample) const
+    {
+        return sample.m_sample_index2 == sample.m_sample_index + 1;
+    }
+
+    bool canTakeSecondSample(const Sample& sample, uint64_t idx, bool force_update) const
+    {
+        return !force_update && sample.m_sample_index2 == (int64_t)idx;
+    }
+
     void readVisibility(Sample& sample, const abcSampleSelector& ss)
     {
         if (m_visibility_prop.valid() && m_visibility_prop.getNumSamples() > 0) {
@@ -240,8 +450,11 @@ protected:
     float m_current_time_interval = 0;
     bool m_sample_index_changed = false;
 
-    bool m_force_update_local = false; // m_force_update for worker thread
+    std::vector<SamplePtr> m_prefetch_samples;
+    std::vector<int64_t> m_prefetch_indices;
+    int m_prefetch_direction = 1;
 
 private:
     aiAsyncLoad m_async_load;
+    aiTaskGroup m_prefetch_tasks;
 };
@@ -22,19 +22,35 @@ aiXform::aiXform(aiObject *parent, const abcObject &abc)
 {
 }
 
+aiXform::~aiXform()
+{
+    waitAsync();
+    waitPrefetch();
+}
+
 aiXform::Sample* aiXform::newSample()
 {
     return new Sample(this);
 }
 
-void aiXform::readSampleBody(Sample& sample, uint64_t idx)
+void aiXform::readSampleBody(Sample& sample, uint64_t idx, bool force_update)
 {
     auto ss = aiIndexToSampleSelector(idx);
-    auto ss2 = aiIndexToSampleSelector(idx + 1);
 
     readVisibility(sample, ss);
-    m_schema.get(sample.xf_sp, ss);
-    m_schema.get(sample.xf_sp2, ss2);
+    if (canTakeSecondSample(sample, idx, force_update))
+        sample.xf_sp = sample.xf_sp2;
+    else
+        m_schema.get(sample.xf_sp, ss);
+    sample.m_sample_index = idx;
+    sample.m_sample_index2 = -1;
+}
+
+abcM44d aiXform::getWorldMatrix(const abcSampleSelector& ss, const abcM44d& parent) const
+{
+    AbcGeom::XformSample xs;
+    const_cast<AbcSchema&>(m_schema).get(xs, ss);
+    return xs.getInheritsXforms() ? xs.getMatrix() * parent : xs.getMatrix();
 }
 
 void aiXform::cookSampleBody(Sample& sample)
@@ -49,6 +65,11 @@ void aiXform::cookSampleBody(Sample& sample)
 
     if (config.interpolate_samples && m_current_time_offset != 0)
     {
+        if (needsSecondSample(sample)) {
+            m_schema.get(sample.xf_sp2, aiIndexToSampleSelector(sample.m_sample_index + 1));
+            sample.m_sample_index2 = sample.m_sample_index + 1;
+        }
+
         Imath::V3d scale2;
         Imath::Quatd rot2;
         Imath::V3d trans2;
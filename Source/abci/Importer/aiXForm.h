@@ -25,9 +25,12 @@ class aiXform : public aiTSchema<aiXformTraits>
 using super = aiTSchema<aiXformTraits>;
 public:
     aiXform(aiObject *parent, const abcObject &abc);
+    ~aiXform() override;
 
     Sample* newSample() override;
-    void readSampleBody(Sample& sample, uint64_t idx) override;
+    void readSampleBody(Sample& sample, uint64_t idx, bool force_update) override;
     void cookSampleBody(Sample& sample) override;
     void decompose(const Imath::M44d &mat, Imath::V3d &scale, Imath::V3d &shear, Imath::Quatd &rotation, Imath::V3d &translation) const;
+    // reads the archive directly. for culling, which runs before samples are updated
+    abcM44d getWorldMatrix(const abcSampleSelector& ss, const abcM44d& parent) const;
 };
@@ -1,11 +1,13 @@
 #include <algorithm>
 #include <numeric>
 #include <map>
+#include <list>
 #include <set>
 #include <vector>
 #include <deque>
 #include <memory>
 #include <thread>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <future>
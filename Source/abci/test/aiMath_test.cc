@@ -0,0 +1,143 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "Foundation/aiMath.h"
+#include "Foundation/RawVector.h"
+
+static uint16_t HalfGeneric(float v)
+{
+    // abcC4 is the only 4 component type, so convert 4 at once
+    float src[4] = { v, v, v, v };
+    uint16_t dst[4];
+    FloatToHalfGeneric(dst, (const abcC4*)src, 1);
+    return dst[0];
+}
+
+TEST(VertexFormats, HalfBits) {
+    EXPECT_EQ(0x0000, HalfGeneric(0.0f));
+    EXPECT_EQ(0x8000, HalfGeneric(-0.0f));
+    EXPECT_EQ(0x3c00, HalfGeneric(1.0f));
+    EXPECT_EQ(0xc000, HalfGeneric(-2.0f));
+    EXPECT_EQ(0x7bff, HalfGeneric(65504.0f));
+
+    // ties round to even
+    EXPECT_EQ(0x3c00, HalfGeneric(1.0f + std::ldexp(1.0f, -11)));
+    EXPECT_EQ(0x3c02, HalfGeneric(1.0f + std::ldexp(3.0f, -11)));
+
+    // overflow, inf and nan
+    EXPECT_EQ(0x7bff, HalfGeneric(65519.0f));
+    EXPECT_EQ(0x7c00, HalfGeneric(65520.0f));
+    EXPECT_EQ(0xfc00, HalfGeneric(-1e10f));
+    EXPECT_EQ(0x7c00, HalfGeneric(std::numeric_limits<float>::infinity()));
+    EXPECT_EQ(0xfc00, HalfGeneric(-std::numeric_limits<float>::infinity()));
+    EXPECT_EQ(0x7e00, HalfGeneric(std::numeric_limits<float>::quiet_NaN()));
+
+    // subnormals
+    EXPECT_EQ(0x0001, HalfGeneric(std::ldexp(1.0f, -24)));
+    EXPECT_EQ(0x0000, HalfGeneric(std::ldexp(1.0f, -25)));
+    EXPECT_EQ(0x0002, HalfGeneric(std::ldexp(3.0f, -25)));
+    EXPECT_EQ(0x03ff, HalfGeneric(std::ldexp(1023.0f, -24)));
+    EXPECT_EQ(0x0400, HalfGeneric(std::ldexp(1.0f, -14)));
+    EXPECT_EQ(0x8001, HalfGeneric(-std::ldexp(1.0f, -24)));
+}
+
+TEST(VertexFormats, UNorm8) {
+    float src[8] = { 0.0f, 1.0f, -1.0f, 2.0f, 0.5f, 1.0f / 255.0f, 0.75f, 0.25f };
+    uint8_t dst[8];
+    FloatToUNorm8Generic(dst, (const abcC4*)src, 2);
+    EXPECT_EQ(0, dst[0]);
+    EXPECT_EQ(255, dst[1]);
+    EXPECT_EQ(0, dst[2]);
+    EXPECT_EQ(255, dst[3]);
+    EXPECT_EQ(128, dst[4]);
+    EXPECT_EQ(1, dst[5]);
+    EXPECT_EQ(191, dst[6]);
+    EXPECT_EQ(64, dst[7]);
+}
+
+TEST(VertexFormats, Octahedral) {
+    float src[] = {
+        0.0f, 0.0f, 1.0f,
+        1.0f, 0.0f, 0.0f,
+        0.0f, -1.0f, 0.0f,
+        0.0f, 0.0f, -1.0f,
+        0.0f, 0.0f, 0.0f,
+    };
+    int16_t dst[10];
+    EncodeNormalsOctahedralGeneric(dst, (const abcV3*)src, 5);
+    EXPECT_EQ(0, dst[0]);      EXPECT_EQ(0, dst[1]);
+    EXPECT_EQ(32767, dst[2]);  EXPECT_EQ(0, dst[3]);
+    EXPECT_EQ(0, dst[4]);      EXPECT_EQ(-32767, dst[5]);
+    EXPECT_EQ(32767, dst[6]);  EXPECT_EQ(32767, dst[7]);
+    EXPECT_EQ(0, dst[8]);      EXPECT_EQ(0, dst[9]);
+
+    float tangents[] = { 1.0f, 0.0f, 0.0f, -1.0f };
+    int16_t dst_t[4];
+    EncodeTangentsOctahedralGeneric(dst_t, (const abcV4*)tangents, 1);
+    EXPECT_EQ(32767, dst_t[0]);
+    EXPECT_EQ(0, dst_t[1]);
+    EXPECT_EQ(-32767, dst_t[2]);
+    EXPECT_EQ(0, dst_t[3]);
+}
+
+#ifdef aiEnableISPC
+// values around every branch of the conversions plus a sweep
+static RawVector<float> MakeInputs()
+{
+    RawVector<float> ret = {
+        0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 65504.0f, 65519.0f, 65520.0f, -65520.0f, 1e10f,
+        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN(),
+        std::ldexp(1.0f, -24), std::ldexp(1.0f, -25), std::ldexp(3.0f, -25), std::ldexp(1023.0f, -24),
+        std::ldexp(1.0f, -14), 1.0f + std::ldexp(1.0f, -11), 1.0f + std::ldexp(3.0f, -11),
+    };
+    for (int i = -4000; i <= 4000; ++i)
+        ret.push_back((float)i * 0.00731f);
+    while (ret.size() % 12 != 0)
+        ret.push_back(0.0f);
+    return ret;
+}
+
+TEST(VertexFormats, GenericMatchesISPC) {
+    auto src = MakeInputs();
+    int n = (int)src.size();
+
+    RawVector<uint16_t> half_g(n), half_i(n);
+    FloatToHalfGeneric(half_g.data(), (const abcC4*)src.data(), n / 4);
+    FloatToHalfISPC(half_i.data(), (const abcC4*)src.data(), n / 4);
+    for (int i = 0; i < n; ++i)
+        ASSERT_EQ(half_g[i], half_i[i]) << "value " << src[i];
+
+    RawVector<uint16_t> half3_g(n / 3 * 4), half3_i(n / 3 * 4);
+    FloatToHalfGeneric(half3_g.data(), (const abcV3*)src.data(), n / 3);
+    FloatToHalfISPC(half3_i.data(), (const abcV3*)src.data(), n / 3);
+    for (int i = 0; i < n / 3 * 4; ++i)
+        ASSERT_EQ(half3_g[i], half3_i[i]);
+
+    RawVector<uint8_t> unorm_g(n), unorm_i(n);
+    FloatToUNorm8Generic(unorm_g.data(), (const abcC4*)src.data(), n / 4);
+    FloatToUNorm8ISPC(unorm_i.data(), (const abcC4*)src.data(), n / 4);
+    for (int i = 0; i < n; ++i)
+        ASSERT_EQ(unorm_g[i], unorm_i[i]) << "value " << src[i];
+
+    // the reciprocal of the ISPC path may be approximated (fast-math), so the encodings can differ by one step
+    RawVector<float> dirs;
+    for (int i = 0; i < n; ++i)
+        if (!std::isnan(src[i]) && !std::isinf(src[i]) && std::abs(src[i]) < 1e5f)
+            dirs.push_back(src[i]);
+    while (dirs.size() % 12 != 0)
+        dirs.push_back(1.0f);
+    int nd = (int)dirs.size();
+
+    RawVector<int16_t> oct_g(nd / 3 * 2), oct_i(nd / 3 * 2);
+    EncodeNormalsOctahedralGeneric(oct_g.data(), (const abcV3*)dirs.data(), nd / 3);
+    EncodeNormalsOctahedralISPC(oct_i.data(), (const abcV3*)dirs.data(), nd / 3);
+    for (int i = 0; i < nd / 3 * 2; ++i)
+        ASSERT_LE(std::abs(oct_g[i] - oct_i[i]), 1);
+
+    RawVector<int16_t> tan_g(nd), tan_i(nd);
+    EncodeTangentsOctahedralGeneric(tan_g.data(), (const abcV4*)dirs.data(), nd / 4);
+    EncodeTangentsOctahedralISPC(tan_i.data(), (const abcV4*)dirs.data(), nd / 4);
+    for (int i = 0; i < nd; ++i)
+        ASSERT_LE(std::abs(tan_g[i] - tan_i[i]), 1);
+}
+#endif
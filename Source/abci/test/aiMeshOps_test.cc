@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include "pch.h"
+#include "Foundation/aiMeshOps.h"
+#include "Importer/aiAsync.h"
+
+// welds must not depend on the number of workers. this makes refineHashed() use several partitions on any machine
+static const bool g_thread_count_set = aiThreadPool::setThreadCount(4);
+
+// quad grid of w x h faces. points are shared by neighbouring faces
+struct Grid
+{
+    RawVector<int> counts;
+    RawVector<int> indices;
+    RawVector<float3> points;
+
+    Grid(int w, int h)
+    {
+        for (int y = 0; y <= h; ++y)
+            for (int x = 0; x <= w; ++x)
+                points.push_back({ (float)x, 0.0f, (float)y });
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                int i = y * (w + 1) + x;
+                counts.push_back(4);
+                indices.push_back(i);
+                indices.push_back(i + w + 1);
+                indices.push_back(i + w + 2);
+                indices.push_back(i + 1);
+            }
+        }
+    }
+
+    void setup(MeshRefiner& refiner, int split_unit = 0)
+    {
+        refiner.clear();
+        refiner.split_unit = split_unit;
+        refiner.counts = { counts.data(), counts.size() };
+        refiner.indices = { indices.data(), indices.size() };
+        refiner.points = { points.data(), points.size() };
+    }
+};
+
+static int TotalVertexCount(const MeshRefiner& refiner)
+{
+    int ret = 0;
+    for (auto& split : refiner.splits)
+        ret += split.vertex_count;
+    return ret;
+}
+
+TEST(MeshRefiner, WeldsGrid) {
+    // large enough to be deduplicated in many partitions
+    const int w = 300, h = 200;
+    Grid grid(w, h);
+
+    // uv per point: every corner of a point is welded
+    RawVector<abcV2> uv;
+    for (auto& p : grid.points)
+        uv.push_back({ p.x / w, p.z / h });
+    RawVector<abcV2> new_uv;
+    RawVector<int> remap_uv;
+    MeshRefiner::Attribute<abcV2> uv0, none;
+    uv0.assign({ uv.data(), uv.size() }, { grid.indices.data(), grid.indices.size() }, new_uv, remap_uv);
+
+    MeshRefiner refiner;
+    grid.setup(refiner);
+    refiner.refineHashed(uv0, none);
+
+    const int vertex_count = (w + 1) * (h + 1);
+    ASSERT_EQ(1, (int)refiner.splits.size());
+    EXPECT_EQ(vertex_count, refiner.splits[0].vertex_count);
+    EXPECT_EQ(vertex_count, (int)refiner.new_points.size());
+    EXPECT_EQ(vertex_count, (int)new_uv.size());
+    EXPECT_EQ(w * h * 4, (int)refiner.new_indices.size());
+    for (int ii = 0; ii < (int)grid.indices.size(); ++ii) {
+        int ni = refiner.new_indices[ii];
+        ASSERT_EQ(grid.indices[ii], refiner.new2old_points[ni]);
+        ASSERT_EQ(uv[grid.indices[ii]], new_uv[ni]);
+    }
+}
+
+TEST(MeshRefiner, KeepsSeams) {
+    const int w = 300, h = 200;
+    Grid grid(w, h);
+
+    // one normal per face: corners of different faces never weld
+    RawVector<abcV3> normals;
+    for (int fi = 0; fi < w * h; ++fi)
+        for (int ci = 0; ci < 4; ++ci)
+            normals.push_back({ 0.0f, 1.0f, (float)fi });
+    RawVector<abcV3> new_normals;
+    RawVector<int> remap_normals;
+    MeshRefiner::Attribute<abcV3> n;
+    n.assign({ normals.data(), normals.size() }, {}, new_normals, remap_normals);
+
+    MeshRefiner refiner;
+    grid.setup(refiner);
+    refiner.refineHashed(n);
+    EXPECT_EQ(w * h * 4, TotalVertexCount(refiner));
+}
+
+TEST(MeshRefiner, WeldsWithinSplits) {
+    const int w = 300, h = 200;
+    const int split_unit = 20000;
+    Grid grid(w, h);
+
+    MeshRefiner refiner;
+    grid.setup(refiner, split_unit);
+    refiner.refineHashed();
+
+    // rows are split apart. points on the rows at the boundaries are emitted once per split
+    ASSERT_GT((int)refiner.splits.size(), 1);
+    int vertex_total = 0, index_total = 0;
+    for (auto& split : refiner.splits) {
+        EXPECT_LE(split.vertex_count, split_unit);
+        EXPECT_EQ(vertex_total, split.vertex_offset);
+        EXPECT_EQ(index_total, split.index_offset);
+        for (int ii = 0; ii < split.index_count; ++ii) {
+            int ni = refiner.new_indices[split.index_offset + ii];
+            ASSERT_GE(ni, split.vertex_offset);
+            ASSERT_LT(ni, split.vertex_offset + split.vertex_count);
+        }
+        vertex_total += split.vertex_count;
+        index_total += split.index_count;
+    }
+    EXPECT_EQ(w * h * 4, index_total);
+    EXPECT_LT(vertex_total, (w + 1) * (h + 1) + (w + 1) * 2 * (int)refiner.splits.size());
+}
@@ -372,15 +372,27 @@ namespace UnityEngine.Formats.Alembic.Sdk
 
 
         [DllImport(Abci.Lib, BestFitMapping = false, ThrowOnUnmappableChar = true)] public static extern void aiClearContextsWithPath(string path);
+        [DllImport(Abci.Lib)] public static extern Bool aiSetThreadCount(int n);
         [DllImport(Abci.Lib)] public static extern aiContext aiContextCreate(int uid);
         [DllImport(Abci.Lib)] public static extern void aiContextDestroy(IntPtr ctx);
         [DllImport(Abci.Lib, BestFitMapping = false, ThrowOnUnmappableChar = true)] public static extern Bool aiContextLoad(IntPtr ctx, string path);
+        [DllImport(Abci.Lib, BestFitMapping = false, ThrowOnUnmappableChar = true)] public static extern Bool aiContextLoadFiltered(IntPtr ctx, string path, string filter);
+        [DllImport(Abci.Lib, BestFitMapping = false, ThrowOnUnmappableChar = true)] public static extern Bool aiContextLoadAsync(IntPtr ctx, string path, string filter);
+        [DllImport(Abci.Lib)] public static extern aiLoadState aiContextGetLoadState(IntPtr ctx);
+        [DllImport(Abci.Lib)] public static extern float aiContextGetLoadProgress(IntPtr ctx);
+        [DllImport(Abci.Lib)] public static extern Bool aiContextWaitLoad(IntPtr ctx);
         [DllImport(Abci.Lib)] public static extern void aiContextSetConfig(IntPtr ctx, ref aiConfig conf);
         [DllImport(Abci.Lib)] public static extern int aiContextGetTimeSamplingCount(IntPtr ctx);
         [DllImport(Abci.Lib)] public static extern aiTimeSampling aiContextGetTimeSampling(IntPtr ctx, int i);
         [DllImport(Abci.Lib)] public static extern void aiContextGetTimeRange(IntPtr ctx, ref double begin, ref double end);
         [DllImport(Abci.Lib)] public static extern aiObject aiContextGetTopObject(IntPtr ctx);
         [DllImport(Abci.Lib)] public static extern void aiContextUpdateSamples(IntPtr ctx, double time);
+        [DllImport(Abci.Lib)] public static extern void aiContextSetViewFrustums(IntPtr ctx, IntPtr frustums, int count);
+        [DllImport(Abci.Lib)] public static extern void aiContextBakeRange(IntPtr ctx, double begin, double end);
+        [DllImport(Abci.Lib)] public static extern void aiContextGetSampleCacheStats(IntPtr ctx, ref aiSampleCacheStats dst);
+        [DllImport(Abci.Lib)] public static extern void aiContextGetHierarchySummary(IntPtr ctx, ref aiHierarchySummary dst);
+        [DllImport(Abci.Lib)] public static extern void aiContextGetHierarchy(IntPtr ctx, ref aiHierarchyData dst);
+        [DllImport(Abci.Lib)] public static extern void aiContextUpdateAndFillPolyMeshes(IntPtr ctx, double time, IntPtr records, int count, IntPtr dst);
 
         [DllImport(Abci.Lib)] public static extern int aiTimeSamplingGetSampleCount(IntPtr self);
         [DllImport(Abci.Lib)] public static extern double aiTimeSamplingGetTime(IntPtr self, int index);
@@ -404,11 +416,16 @@ namespace UnityEngine.Formats.Alembic.Sdk
         [DllImport(Abci.Lib)] public static extern aiSample aiSchemaGetSample(IntPtr schema);
         [DllImport(Abci.Lib)] public static extern Bool aiSchemaIsConstant(IntPtr schema);
         [DllImport(Abci.Lib)] public static extern Bool aiSchemaIsDataUpdated(IntPtr schema);
+        [DllImport(Abci.Lib)] public static extern Bool aiSchemaIsCulled(IntPtr schema);
         [DllImport(Abci.Lib)] public static extern int aiSchemaGetNumProperties(IntPtr schema);
         [DllImport(Abci.Lib)] public static extern aiProperty aiSchemaGetPropertyByIndex(IntPtr schema, int i);
         [DllImport(Abci.Lib, BestFitMapping = false, ThrowOnUnmappableChar = true)] public static extern aiProperty aiSchemaGetPropertyByName(IntPtr schema, string name);
 
         [DllImport(Abci.Lib)] public static extern void aiPolyMeshGetSummary(IntPtr schema, ref aiMeshSummary dst);
+        [DllImport(Abci.Lib)] public static extern void aiPolyMeshSetVertexBuffers(IntPtr schema, IntPtr vbs, int splitCount);
+        [DllImport(Abci.Lib)] public static extern void aiPolyMeshSetVertexFormats(IntPtr schema, ref aiPolyMeshVertexFormats formats);
+        [DllImport(Abci.Lib)] public static extern void aiPolyMeshSetIndexFormat(IntPtr schema, aiIndexFormat format);
+        [DllImport(Abci.Lib)] public static extern void aiPolyMeshSetSkipUnchanged(IntPtr schema, Bool v);
 
         [DllImport(Abci.Lib)] public static extern void aiPointsSetSort(IntPtr schema, Bool v);
         [DllImport(Abci.Lib)] public static extern void aiPointsSetSortBasePosition(IntPtr schema, Vector3 v);
@@ -47,6 +47,59 @@ namespace UnityEngine.Formats.Alembic.Sdk
         Acyclic,
     };
 
+    internal enum aiLoadState
+    {
+        None,
+        Loading,
+        Succeeded,
+        Failed,
+    };
+
+    internal enum aiSchemaType
+    {
+        None,
+        Xform,
+        Camera,
+        PolyMesh,
+        Points,
+    };
+
+    internal enum aiBatchStatus
+    {
+        Filled,
+        NotUpdated,
+        NeedsResize,
+        Invalid,
+    };
+
+    internal enum aiVertexFormat
+    {
+        Float,
+        Half,
+        SNorm16Oct,
+        UNorm8,
+    };
+
+    [Flags]
+    internal enum aiPolyMeshAttributeBits : uint
+    {
+        Points = 1 << 0,
+        Velocities = 1 << 1,
+        Normals = 1 << 2,
+        Tangents = 1 << 3,
+        UV0 = 1 << 4,
+        UV1 = 1 << 5,
+        Colors = 1 << 6,
+        Indices = 1 << 7,
+        All = 0xff,
+    };
+
+    internal enum aiIndexFormat
+    {
+        UInt32,
+        UInt16IfPossible,
+    };
+
     internal enum aiPropertyType
     {
         Unknown,
@@ -94,6 +147,13 @@ namespace UnityEngine.Formats.Alembic.Sdk
         public Bool importLinePolygon { get; set; }
         public Bool importTrianglePolygon { get; set; }
 
+        public Bool parallelUpdate { get; set; }
+        public int readAheadSamples { get; set; }
+        public long sampleCacheBudget { get; set; }
+        public Bool eagerLoad { get; set; }
+        public Bool trustFileBounds { get; set; }
+        public Bool skipHiddenSamples { get; set; }
+
         public void SetDefaults()
         {
             normalsMode = aiNormalsMode.CalculateIfMissing;
@@ -113,9 +173,47 @@ namespace UnityEngine.Formats.Alembic.Sdk
             importPointPolygon = true;
             importLinePolygon = true;
             importTrianglePolygon = true;
+            parallelUpdate = false;
+            readAheadSamples = 0;
+            sampleCacheBudget = 0;
+            eagerLoad = false;
+            trustFileBounds = false;
+            skipHiddenSamples = false;
         }
     }
 
+    internal struct aiSampleCacheStats
+    {
+        public ulong hits { get; set; }
+        public ulong misses { get; set; }
+        public ulong usedBytes { get; set; }
+        public ulong budgetBytes { get; set; }
+        public int entryCount { get; set; }
+    }
+
+    internal struct aiFrustum
+    {
+        public Vector4 plane0, plane1, plane2, plane3, plane4, plane5;
+    }
+
+    internal struct aiHierarchySummary
+    {
+        public int nodeCount { get; set; }
+        public int nameBufferSize { get; set; }
+    }
+
+    // each array has nodeCount elements in depth first order. index 0 is the top object.
+    internal struct aiHierarchyData
+    {
+        public IntPtr objects;              // aiObject[]
+        public IntPtr parentIndices;        // int[]. -1 for the top object
+        public IntPtr schemaTypes;          // aiSchemaType[]
+        public IntPtr nameOffsets;          // int[]
+        public IntPtr names;                // byte[nameBufferSize]. null terminated names
+        public IntPtr timeSamplingIndices;  // int[]
+        public IntPtr constantFlags;        // Bool[]
+    }
+
     internal struct aiSampleSelector
     {
         public ulong requestedIndex { get; set; }
@@ -123,6 +221,17 @@ namespace UnityEngine.Formats.Alembic.Sdk
         public int requestedTimeIndexType { get; set; }
     }
 
+    internal struct aiPolyMeshVertexFormats
+    {
+        public aiVertexFormat points { get; set; }
+        public aiVertexFormat velocities { get; set; }
+        public aiVertexFormat normals { get; set; }
+        public aiVertexFormat tangents { get; set; }
+        public aiVertexFormat uv0 { get; set; }
+        public aiVertexFormat uv1 { get; set; }
+        public aiVertexFormat colors { get; set; }
+    }
+
     internal struct aiMeshSummary
     {
         public aiTopologyVariance topologyVariance { get; set; }
@@ -153,6 +262,7 @@ namespace UnityEngine.Formats.Alembic.Sdk
         public int vertexCount { get; set; }
         public int indexCount { get; set; }
         public Bool topologyChanged { get; set; }
+        public aiPolyMeshAttributeBits changed { get; set; }
     }
 
     internal struct aiMeshSplitSummary
@@ -163,6 +273,7 @@ namespace UnityEngine.Formats.Alembic.Sdk
         public int vertexOffset { get; set; }
         public int indexCount { get; set; }
         public int indexOffset { get; set; }
+        public int indexSize { get; set; }
     }
 
     internal struct aiSubmeshSummary
@@ -214,6 +325,23 @@ namespace UnityEngine.Formats.Alembic.Sdk
     internal struct aiSubmeshData
     {
         public IntPtr indexes;
+        public int indexCount; // capacity of indexes. checked only by aiContext.UpdateAndFillPolyMeshes()
+    }
+
+    internal struct aiPolyMeshBatchRecord
+    {
+        public aiPolyMesh schema;
+        public IntPtr vbs; // aiPolyMeshData[splitCount]. vertexCount of each is the capacity of its buffers
+        public IntPtr ibs; // aiSubmeshData[submeshCount]
+        public int splitCount;
+        public int submeshCount;
+    }
+
+    internal struct aiPolyMeshBatchResult
+    {
+        public aiBatchStatus status;
+        public Bool visibility;
+        public aiPolyMeshAttributeBits changed;
     }
 
     internal struct aiXformData
@@ -314,16 +442,32 @@ namespace UnityEngine.Formats.Alembic.Sdk
 
         public static aiContext Create(int uid) { return NativeMethods.aiContextCreate(uid); }
         public static void DestroyByPath(string path) { NativeMethods.aiClearContextsWithPath(path); }
+        // shared by all contexts. effective only before the first context is used
+        public static bool SetThreadCount(int n) { return NativeMethods.aiSetThreadCount(n); }
 
         public void Destroy() { NativeMethods.aiContextDestroy(self); self = IntPtr.Zero; }
         public bool Load(string path) { return NativeMethods.aiContextLoad(self, path); }
+        public bool Load(string path, string filter) { return NativeMethods.aiContextLoadFiltered(self, path, filter); }
+        public bool LoadAsync(string path, string filter = null) { return NativeMethods.aiContextLoadAsync(self, path, filter); }
+        public bool WaitLoad() { return NativeMethods.aiContextWaitLoad(self); }
+        internal aiLoadState loadState { get { return NativeMethods.aiContextGetLoadState(self); } }
+        public float loadProgress { get { return NativeMethods.aiContextGetLoadProgress(self); } }
         internal void SetConfig(ref aiConfig conf) { NativeMethods.aiContextSetConfig(self, ref conf); }
         public void UpdateSamples(double time) { NativeMethods.aiContextUpdateSamples(self, time); }
+        internal void SetViewFrustums(PinnedList<aiFrustum> frustums) { NativeMethods.aiContextSetViewFrustums(self, frustums, frustums != null ? frustums.Count : 0); }
+        public void BakeRange(double begin, double end) { NativeMethods.aiContextBakeRange(self, begin, end); }
 
         internal aiObject topObject { get { return NativeMethods.aiContextGetTopObject(self); } }
         public int timeSamplingCount { get { return NativeMethods.aiContextGetTimeSamplingCount(self); } }
         public aiTimeSampling GetTimeSampling(int i) { return NativeMethods.aiContextGetTimeSampling(self, i); }
         internal void GetTimeRange(ref double begin, ref double end) { NativeMethods.aiContextGetTimeRange(self, ref begin, ref end); }
+        internal void GetSampleCacheStats(ref aiSampleCacheStats dst) { NativeMethods.aiContextGetSampleCacheStats(self, ref dst); }
+        internal void GetHierarchySummary(ref aiHierarchySummary dst) { NativeMethods.aiContextGetHierarchySummary(self, ref dst); }
+        internal void GetHierarchy(ref aiHierarchyData dst) { NativeMethods.aiContextGetHierarchy(self, ref dst); }
+        internal void UpdateAndFillPolyMeshes(double time, PinnedList<aiPolyMeshBatchRecord> records, PinnedList<aiPolyMeshBatchResult> dst)
+        {
+            NativeMethods.aiContextUpdateAndFillPolyMeshes(self, time, records, records.Count, dst);
+        }
     }
 
     internal struct aiTimeSampling
@@ -395,6 +539,7 @@ namespace UnityEngine.Formats.Alembic.Sdk
 
         public bool isConstant { get { return NativeMethods.aiSchemaIsConstant(self); } }
         public bool isDataUpdated { get { NativeMethods.aiSchemaSync(self); return NativeMethods.aiSchemaIsDataUpdated(self); } }
+        public bool isCulled { get { return NativeMethods.aiSchemaIsCulled(self); } }
         internal aiSample sample { get { return NativeMethods.aiSchemaGetSample(self); } }
 
         public void UpdateSample(ref aiSampleSelector ss) { NativeMethods.aiSchemaUpdateSample(self, ref ss); }
@@ -432,6 +577,10 @@ namespace UnityEngine.Formats.Alembic.Sdk
 
         public aiPolyMeshSample sample { get { return NativeMethods.aiPolyMesh.aiSchemaGetSample(self); } }
         public void GetSummary(ref aiMeshSummary dst) { NativeMethods.aiPolyMeshGetSummary(self, ref dst); }
+        internal void SetVertexBuffers(PinnedList<aiPolyMeshData> vbs) { NativeMethods.aiPolyMeshSetVertexBuffers(self, vbs, vbs != null ? vbs.Count : 0); }
+        internal void SetVertexFormats(ref aiPolyMeshVertexFormats formats) { NativeMethods.aiPolyMeshSetVertexFormats(self, ref formats); }
+        internal aiIndexFormat indexFormat { set { NativeMethods.aiPolyMeshSetIndexFormat(self, value); } }
+        internal bool skipUnchanged { set { NativeMethods.aiPolyMeshSetSkipUnchanged(self, value); } }
     }
 
     [StructLayout(LayoutKind.Explicit)]
@@ -135,6 +135,7 @@ namespace UnityEngine.Formats.Alembic.Importer
             m_config.importPointPolygon = settings.ImportPointPolygon;
             m_config.importLinePolygon = settings.ImportLinePolygon;
             m_config.importTrianglePolygon = settings.ImportTrianglePolygon;
+            m_config.skipHiddenSamples = settings.ImportVisibility;
 
             m_context.SetConfig(ref m_config);
             m_loaded = m_context.Load(m_streamDesc.PathToAbc);
@@ -146,7 +146,10 @@ namespace UnityEngine.Formats.Alembic.Importer
 
         void OnApplicationQuit()
         {
+#if !UNITY_EDITOR
+            // stops the plugin's worker threads before it is unloaded. the editor keeps using them after play mode
             NativeMethods.aiCleanup();
+#endif
         }
         #endregion
     }